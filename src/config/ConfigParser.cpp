@@ -2,6 +2,17 @@
 
 ConfigParser::ConfigParser(const String& filename) : _lexer(filename), _haveHttp(false), _httpClientMaxBody(-1) {
     nextToken();
+    _httpDirectives["event_backend"]         = &HttpConfig::setEventBackend;
+    _httpDirectives["worker_processes"]      = &HttpConfig::setWorkerProcesses;
+    _httpDirectives["worker_cpu_affinity"]   = &HttpConfig::setWorkerCpuAffinity;
+    _httpDirectives["worker_threads"]        = &HttpConfig::setWorkerThreads;
+    _httpDirectives["accept_budget"]         = &HttpConfig::setAcceptBudget;
+    _httpDirectives["worker_connections"]    = &HttpConfig::setWorkerConnections;
+    _httpDirectives["pipeline_depth"]        = &HttpConfig::setPipelineDepth;
+    _httpDirectives["open_file_cache"]       = &HttpConfig::setOpenFileCache;
+    _httpDirectives["open_file_cache_valid"] = &HttpConfig::setOpenFileCacheValid;
+    _httpDirectives["content_cache"]         = &HttpConfig::setContentCache;
+
     _serverDirectives["listen"]               = &ServerConfig::setListen;
     _serverDirectives["server_name"]          = &ServerConfig::setServerName;
     _serverDirectives["root"]                 = &ServerConfig::setRoot;
@@ -19,10 +30,20 @@ ConfigParser::ConfigParser(const String& filename) : _lexer(filename), _haveHttp
     _locationDirectives["cgi_pass"]             = &LocationConfig::setCgiPass;
     _locationDirectives["upload_dir"]           = &LocationConfig::setUploadDir;
     _locationDirectives["error_page"]           = &LocationConfig::setErrorPage;
+    _locationDirectives["gzip_static"]          = &LocationConfig::setGzipStatic;
+    _locationDirectives["brotli_static"]        = &LocationConfig::setBrotliStatic;
+    _locationDirectives["gzip"]                 = &LocationConfig::setGzip;
+    _locationDirectives["gzip_types"]           = &LocationConfig::setGzipTypes;
+    _locationDirectives["gzip_min_length"]      = &LocationConfig::setGzipMinLength;
+    _locationDirectives["gzip_comp_level"]      = &LocationConfig::setGzipCompLevel;
+    _locationDirectives["expires"]              = &LocationConfig::setExpires;
+    _locationDirectives["expires_by_type"]      = &LocationConfig::setExpiresByType;
+    _locationDirectives["cache_control"]        = &LocationConfig::setCacheControl;
+    _locationDirectives["cache_control_by_type"] = &LocationConfig::setCacheControlByType;
 }
 
 
-ConfigParser::ConfigParser() : _lexer(), _current(), _haveHttp(false), _servers(), _httpClientMaxBody(-1) {}
+ConfigParser::ConfigParser() : _lexer(), _current(), _haveHttp(false), _servers(), _httpClientMaxBody(-1), _httpConfig() {}
 
 ConfigParser::ConfigParser(const ConfigParser& other)
     : _lexer(other._lexer),
@@ -30,6 +51,8 @@ ConfigParser::ConfigParser(const ConfigParser& other)
     _haveHttp(other._haveHttp),
     _servers(other._servers),
     _httpClientMaxBody(other._httpClientMaxBody),
+    _httpConfig(other._httpConfig),
+    _httpDirectives(other._httpDirectives),
     _serverDirectives(other._serverDirectives),
     _locationDirectives(other._locationDirectives)
 {}
@@ -41,6 +64,8 @@ ConfigParser& ConfigParser::operator=(const ConfigParser& other) {
         _haveHttp = other._haveHttp;
         _servers = other._servers;
         _httpClientMaxBody = other._httpClientMaxBody;
+        _httpConfig = other._httpConfig;
+        _httpDirectives = other._httpDirectives;
         _serverDirectives = other._serverDirectives;
         _locationDirectives = other._locationDirectives;
     }
@@ -108,6 +133,9 @@ bool ConfigParser::parseHttp() {
             nextToken();
             if (!expect(TOKEN_SEMICOLON, "';' after client_max_body_size"))
                 return false;
+        } else if (_current.getType() == TOKEN_WORD && keyExists(_httpDirectives, _current.getValue())) {
+            if (!parseHttpDirective())
+                return false;
         } else {
             return error("Invalid directive in http block: '" + _current.getValue() + "'");
         }
@@ -116,6 +144,23 @@ bool ConfigParser::parseHttp() {
     return true;
 }
 
+bool ConfigParser::parseHttpDirective() {
+    String key = _current.getValue();
+    nextToken();
+
+    VectorString values;
+    while (_current.getType() != TOKEN_SEMICOLON) {
+        if (_current.getType() != TOKEN_WORD && _current.getType() != TOKEN_STRING)
+            return error("Expected value or ';'");
+        values.push_back(_current.getValue());
+        nextToken();
+    }
+    nextToken();
+
+    const HttpSetter setter = getValue<HttpDirectiveMap, String, HttpSetter>(_httpDirectives, key);
+    return (_httpConfig.*(setter))(values);
+}
+
 bool ConfigParser::parseServer() {
     nextToken();
     if (!expect(TOKEN_LBRACE, "'{' after server"))
@@ -247,4 +292,8 @@ const VectorServerConfig& ConfigParser::getServers() const {
 
 const ssize_t& ConfigParser::getHttpClientMaxBody() const {
     return _httpClientMaxBody;
+}
+
+const HttpConfig& ConfigParser::getHttpConfig() const {
+    return _httpConfig;
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #ifndef CONFIG_PARSER_HPP
 #define CONFIG_PARSER_HPP
 
+#include "../config/HttpConfig.hpp"
 #include "../config/LocationConfig.hpp"
 #include "../config/ServerConfig.hpp"
 #include "../utils/Utils.hpp"
@@ -17,6 +18,7 @@ class ConfigParser {
     bool                      parse();
     const VectorServerConfig& getServers() const;
     const ssize_t&            getHttpClientMaxBody() const;
+    const HttpConfig&         getHttpConfig() const;
 
    private:
     ConfigLexer        _lexer;
@@ -24,7 +26,9 @@ class ConfigParser {
     bool               _haveHttp;
     VectorServerConfig _servers;
     ssize_t            _httpClientMaxBody;
+    HttpConfig         _httpConfig;
 
+    HttpDirectiveMap     _httpDirectives;
     ServerDirectiveMap   _serverDirectives;
     LocationDirectiveMap _locationDirectives;
 
@@ -33,6 +37,7 @@ class ConfigParser {
     bool expect(Type type, const String& expectedDesc);
 
     bool parseHttp();
+    bool parseHttpDirective();
     bool parseServer();
     bool parseLocation(ServerConfig& srv);
     bool validate();
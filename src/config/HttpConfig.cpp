@@ -0,0 +1,305 @@
+#include "HttpConfig.hpp"
+
+HttpConfig::HttpConfig()
+    : eventBackend(BACKEND_EPOLL),
+      eventBackendSet(false),
+      workerProcesses(1),
+      workerProcessesSet(false),
+      workerCpuAffinity(false),
+      workerCpuAffinitySet(false),
+      workerThreads(1),
+      workerThreadsSet(false),
+      acceptBudget(DEFAULT_ACCEPT_BUDGET),
+      acceptBudgetSet(false),
+      workerConnections(MAX_CONNECTIONS),
+      workerConnectionsSet(false),
+      pipelineDepth(DEFAULT_PIPELINE_DEPTH),
+      pipelineDepthSet(false),
+      openFileCacheMax(0),
+      openFileCacheSet(false),
+      openFileCacheInactive(OPEN_FILE_CACHE_INACTIVE),
+      openFileCacheValid(OPEN_FILE_CACHE_VALID),
+      openFileCacheValidSet(false),
+      contentCacheSize(0),
+      contentCacheSet(false),
+      contentCacheMaxFile(CONTENT_CACHE_MAX_FILE) {}
+
+HttpConfig::HttpConfig(const HttpConfig& other)
+    : eventBackend(other.eventBackend),
+      eventBackendSet(other.eventBackendSet),
+      workerProcesses(other.workerProcesses),
+      workerProcessesSet(other.workerProcessesSet),
+      workerCpuAffinity(other.workerCpuAffinity),
+      workerCpuAffinitySet(other.workerCpuAffinitySet),
+      workerThreads(other.workerThreads),
+      workerThreadsSet(other.workerThreadsSet),
+      acceptBudget(other.acceptBudget),
+      acceptBudgetSet(other.acceptBudgetSet),
+      workerConnections(other.workerConnections),
+      workerConnectionsSet(other.workerConnectionsSet),
+      pipelineDepth(other.pipelineDepth),
+      pipelineDepthSet(other.pipelineDepthSet),
+      openFileCacheMax(other.openFileCacheMax),
+      openFileCacheSet(other.openFileCacheSet),
+      openFileCacheInactive(other.openFileCacheInactive),
+      openFileCacheValid(other.openFileCacheValid),
+      openFileCacheValidSet(other.openFileCacheValidSet),
+      contentCacheSize(other.contentCacheSize),
+      contentCacheSet(other.contentCacheSet),
+      contentCacheMaxFile(other.contentCacheMaxFile) {}
+
+HttpConfig& HttpConfig::operator=(const HttpConfig& other) {
+    if (this != &other) {
+        eventBackend          = other.eventBackend;
+        eventBackendSet       = other.eventBackendSet;
+        workerProcesses       = other.workerProcesses;
+        workerProcessesSet    = other.workerProcessesSet;
+        workerCpuAffinity     = other.workerCpuAffinity;
+        workerCpuAffinitySet  = other.workerCpuAffinitySet;
+        workerThreads         = other.workerThreads;
+        workerThreadsSet      = other.workerThreadsSet;
+        acceptBudget          = other.acceptBudget;
+        acceptBudgetSet       = other.acceptBudgetSet;
+        workerConnections     = other.workerConnections;
+        workerConnectionsSet  = other.workerConnectionsSet;
+        pipelineDepth         = other.pipelineDepth;
+        pipelineDepthSet      = other.pipelineDepthSet;
+        openFileCacheMax      = other.openFileCacheMax;
+        openFileCacheSet      = other.openFileCacheSet;
+        openFileCacheInactive = other.openFileCacheInactive;
+        openFileCacheValid    = other.openFileCacheValid;
+        openFileCacheValidSet = other.openFileCacheValidSet;
+        contentCacheSize      = other.contentCacheSize;
+        contentCacheSet       = other.contentCacheSet;
+        contentCacheMaxFile   = other.contentCacheMaxFile;
+    }
+    return *this;
+}
+
+HttpConfig::~HttpConfig() {}
+
+bool HttpConfig::setEventBackend(const VectorString& v) {
+    if (eventBackendSet)
+        return Logger::error("duplicate event_backend directive");
+    if (!requireSingleValue(v, "event_backend"))
+        return false;
+    if (v[0] == "epoll")
+        eventBackend = BACKEND_EPOLL;
+    else if (v[0] == "poll")
+        eventBackend = BACKEND_POLL;
+    else
+        return Logger::error("invalid event_backend value (must be 'epoll' or 'poll'): " + v[0]);
+    eventBackendSet = true;
+    return true;
+}
+
+bool HttpConfig::setWorkerProcesses(const VectorString& v) {
+    if (workerProcessesSet)
+        return Logger::error("duplicate worker_processes directive");
+    if (!requireSingleValue(v, "worker_processes"))
+        return false;
+    if (v[0] == "auto") {
+        long cpus       = sysconf(_SC_NPROCESSORS_ONLN);
+        workerProcesses = cpus > 0 ? static_cast<size_t>(cpus) : 1;
+    } else {
+        int parsed;
+        if (!stringToType<int>(v[0], parsed) || parsed < 1 || parsed > MAX_WORKER_PROCESSES)
+            return Logger::error("invalid worker_processes value (must be 'auto' or 1-" + typeToString(MAX_WORKER_PROCESSES) + "): " + v[0]);
+        workerProcesses = static_cast<size_t>(parsed);
+    }
+    workerProcessesSet = true;
+    return true;
+}
+
+bool HttpConfig::setWorkerCpuAffinity(const VectorString& v) {
+    if (workerCpuAffinitySet)
+        return Logger::error("duplicate worker_cpu_affinity directive");
+    if (!requireSingleValue(v, "worker_cpu_affinity"))
+        return false;
+    if (v[0] == "auto")
+        workerCpuAffinity = true;
+    else if (v[0] == "off")
+        workerCpuAffinity = false;
+    else
+        return Logger::error("invalid worker_cpu_affinity value (must be 'auto' or 'off'): " + v[0]);
+    workerCpuAffinitySet = true;
+    return true;
+}
+
+bool HttpConfig::setWorkerThreads(const VectorString& v) {
+    if (workerThreadsSet)
+        return Logger::error("duplicate worker_threads directive");
+    if (!requireSingleValue(v, "worker_threads"))
+        return false;
+    int parsed;
+    if (!stringToType<int>(v[0], parsed) || parsed < 1 || parsed > MAX_WORKER_THREADS)
+        return Logger::error("invalid worker_threads value (must be 1-" + typeToString(MAX_WORKER_THREADS) + "): " + v[0]);
+    workerThreads    = static_cast<size_t>(parsed);
+    workerThreadsSet = true;
+    return true;
+}
+
+bool HttpConfig::setAcceptBudget(const VectorString& v) {
+    if (acceptBudgetSet)
+        return Logger::error("duplicate accept_budget directive");
+    if (!requireSingleValue(v, "accept_budget"))
+        return false;
+    int parsed;
+    if (!stringToType<int>(v[0], parsed) || parsed < 1 || parsed > MAX_CONNECTIONS)
+        return Logger::error("invalid accept_budget value (must be 1-" + typeToString(MAX_CONNECTIONS) + "): " + v[0]);
+    acceptBudget    = static_cast<size_t>(parsed);
+    acceptBudgetSet = true;
+    return true;
+}
+
+bool HttpConfig::setWorkerConnections(const VectorString& v) {
+    if (workerConnectionsSet)
+        return Logger::error("duplicate worker_connections directive");
+    if (!requireSingleValue(v, "worker_connections"))
+        return false;
+    int parsed;
+    if (!stringToType<int>(v[0], parsed) || parsed < 1 || parsed > MAX_WORKER_CONNECTIONS)
+        return Logger::error("invalid worker_connections value (must be 1-" + typeToString(MAX_WORKER_CONNECTIONS) + "): " + v[0]);
+    workerConnections    = static_cast<size_t>(parsed);
+    workerConnectionsSet = true;
+    return true;
+}
+
+bool HttpConfig::setPipelineDepth(const VectorString& v) {
+    if (pipelineDepthSet)
+        return Logger::error("duplicate pipeline_depth directive");
+    if (!requireSingleValue(v, "pipeline_depth"))
+        return false;
+    int parsed;
+    if (!stringToType<int>(v[0], parsed) || parsed < 1 || parsed > MAX_PIPELINE_DEPTH)
+        return Logger::error("invalid pipeline_depth value (must be 1-" + typeToString(MAX_PIPELINE_DEPTH) + "): " + v[0]);
+    pipelineDepth    = static_cast<size_t>(parsed);
+    pipelineDepthSet = true;
+    return true;
+}
+
+// open_file_cache off | max=N [inactive=time]
+bool HttpConfig::setOpenFileCache(const VectorString& v) {
+    if (openFileCacheSet)
+        return Logger::error("duplicate open_file_cache directive");
+    if (v.empty())
+        return Logger::error("open_file_cache requires a value");
+    openFileCacheSet = true;
+    if (v.size() == 1 && v[0] == "off") {
+        openFileCacheMax = 0;
+        return true;
+    }
+    bool hasMax = false;
+    for (size_t i = 0; i < v.size(); ++i) {
+        String key, value;
+        if (!splitByChar(v[i], key, value, '='))
+            return Logger::error("invalid open_file_cache parameter: " + v[i]);
+        if (key == "max") {
+            int parsed;
+            if (!stringToType<int>(value, parsed) || parsed < 1 || parsed > MAX_OPEN_FILE_CACHE)
+                return Logger::error("invalid open_file_cache max (must be 1-" + typeToString(MAX_OPEN_FILE_CACHE) + "): " + value);
+            openFileCacheMax = static_cast<size_t>(parsed);
+            hasMax           = true;
+        } else if (key == "inactive") {
+            if (!parseSeconds(value, openFileCacheInactive) || openFileCacheInactive < 1)
+                return Logger::error("invalid open_file_cache inactive time: " + value);
+        } else
+            return Logger::error("invalid open_file_cache parameter: " + v[i]);
+    }
+    if (!hasMax)
+        return Logger::error("open_file_cache requires max=N or off");
+    return true;
+}
+
+bool HttpConfig::setOpenFileCacheValid(const VectorString& v) {
+    if (openFileCacheValidSet)
+        return Logger::error("duplicate open_file_cache_valid directive");
+    if (!requireSingleValue(v, "open_file_cache_valid"))
+        return false;
+    if (!parseSeconds(v[0], openFileCacheValid) || openFileCacheValid < 1)
+        return Logger::error("invalid open_file_cache_valid value: " + v[0]);
+    openFileCacheValidSet = true;
+    return true;
+}
+
+bool HttpConfig::setContentCache(const VectorString& v) {
+    if (contentCacheSet)
+        return Logger::error("duplicate content_cache directive");
+    if (v.empty())
+        return Logger::error("content_cache requires a value");
+    contentCacheSet = true;
+    if (v.size() == 1 && v[0] == "off") {
+        contentCacheSize = 0;
+        return true;
+    }
+    bool hasSize = false;
+    for (size_t i = 0; i < v.size(); ++i) {
+        String key, value;
+        if (!splitByChar(v[i], key, value, '='))
+            return Logger::error("invalid content_cache parameter: " + v[i]);
+        if (key == "size") {
+            if (!parseByteSize(value, contentCacheSize) || contentCacheSize < 1)
+                return Logger::error("invalid content_cache size (1 byte to 1g): " + value);
+            hasSize = true;
+        } else if (key == "max_file") {
+            if (!parseByteSize(value, contentCacheMaxFile) || contentCacheMaxFile < 1)
+                return Logger::error("invalid content_cache max_file: " + value);
+        } else
+            return Logger::error("invalid content_cache parameter: " + v[i]);
+    }
+    if (!hasSize)
+        return Logger::error("content_cache requires size=N or off");
+    return true;
+}
+
+EventBackendType HttpConfig::getEventBackend() const {
+    return eventBackend;
+}
+
+String HttpConfig::getEventBackendName() const {
+    return eventBackend == BACKEND_EPOLL ? "epoll" : "poll";
+}
+
+size_t HttpConfig::getWorkerProcesses() const {
+    return workerProcesses;
+}
+
+bool HttpConfig::getWorkerCpuAffinity() const {
+    return workerCpuAffinity;
+}
+
+size_t HttpConfig::getWorkerThreads() const {
+    return workerThreads;
+}
+
+size_t HttpConfig::getAcceptBudget() const {
+    return acceptBudget;
+}
+
+size_t HttpConfig::getWorkerConnections() const {
+    return workerConnections;
+}
+
+size_t HttpConfig::getPipelineDepth() const {
+    return pipelineDepth;
+}
+
+size_t HttpConfig::getOpenFileCacheMax() const {
+    return openFileCacheMax;
+}
+
+time_t HttpConfig::getOpenFileCacheInactive() const {
+    return openFileCacheInactive;
+}
+
+time_t HttpConfig::getOpenFileCacheValid() const {
+    return openFileCacheValid;
+}
+
+size_t HttpConfig::getContentCacheSize() const {
+    return contentCacheSize;
+}
+
+size_t HttpConfig::getContentCacheMaxFile() const {
+    return contentCacheMaxFile;
+}
@@ -0,0 +1,65 @@
+#ifndef HTTP_CONFIG_HPP
+#define HTTP_CONFIG_HPP
+#include <iostream>
+#include "../utils/Logger.hpp"
+#include "../utils/Utils.hpp"
+
+class HttpConfig {
+   public:
+    HttpConfig();
+    HttpConfig(const HttpConfig& other);
+    HttpConfig& operator=(const HttpConfig& other);
+    ~HttpConfig();
+
+    // setters
+    bool setEventBackend(const VectorString& v);
+    bool setWorkerProcesses(const VectorString& v);
+    bool setWorkerCpuAffinity(const VectorString& v);
+    bool setWorkerThreads(const VectorString& v);
+    bool setAcceptBudget(const VectorString& v);
+    bool setWorkerConnections(const VectorString& v);
+    bool setPipelineDepth(const VectorString& v);
+    bool setOpenFileCache(const VectorString& v);
+    bool setOpenFileCacheValid(const VectorString& v);
+    bool setContentCache(const VectorString& v);
+
+    // getters
+    EventBackendType getEventBackend() const;
+    String           getEventBackendName() const;
+    size_t           getWorkerProcesses() const;
+    bool             getWorkerCpuAffinity() const;
+    size_t           getWorkerThreads() const;
+    size_t           getAcceptBudget() const;
+    size_t           getWorkerConnections() const;
+    size_t           getPipelineDepth() const;
+    size_t           getOpenFileCacheMax() const;
+    time_t           getOpenFileCacheInactive() const;
+    time_t           getOpenFileCacheValid() const;
+    size_t           getContentCacheSize() const;
+    size_t           getContentCacheMaxFile() const;
+
+   private:
+    EventBackendType eventBackend;          // default: epoll (falls back to poll when unavailable)
+    bool             eventBackendSet;       // tracks if event_backend directive was used
+    size_t           workerProcesses;       // default: 1 (no master/worker split)
+    bool             workerProcessesSet;    // tracks if worker_processes directive was used
+    bool             workerCpuAffinity;     // default: off
+    bool             workerCpuAffinitySet;  // tracks if worker_cpu_affinity directive was used
+    size_t           workerThreads;         // default: 1 (single event loop per process)
+    bool             workerThreadsSet;      // tracks if worker_threads directive was used
+    size_t           acceptBudget;          // default: DEFAULT_ACCEPT_BUDGET connections per wakeup
+    bool             acceptBudgetSet;       // tracks if accept_budget directive was used
+    size_t           workerConnections;     // default: MAX_CONNECTIONS clients per event loop
+    bool             workerConnectionsSet;  // tracks if worker_connections directive was used
+    size_t           pipelineDepth;         // default: DEFAULT_PIPELINE_DEPTH queued responses per connection
+    bool             pipelineDepthSet;      // tracks if pipeline_depth directive was used
+    size_t           openFileCacheMax;      // default: 0 (open_file_cache off)
+    bool             openFileCacheSet;      // tracks if open_file_cache directive was used
+    time_t           openFileCacheInactive; // seconds without a hit before an entry is dropped
+    time_t           openFileCacheValid;    // seconds before an entry is revalidated
+    bool             openFileCacheValidSet; // tracks if open_file_cache_valid directive was used
+    size_t           contentCacheSize;      // default: 0 bytes (content_cache off)
+    bool             contentCacheSet;       // tracks if content_cache directive was used
+    size_t           contentCacheMaxFile;   // largest file kept in the content cache
+};
+#endif
@@ -5,6 +5,22 @@ LocationConfig::LocationConfig()
       root(),
       autoIndex(false),
       autoIndexSet(false),
+      gzipStatic(false),
+      gzipStaticSet(false),
+      brotliStatic(false),
+      brotliStaticSet(false),
+      gzip(false),
+      gzipSet(false),
+      gzipTypes(),
+      gzipMinLength(GZIP_MIN_LENGTH),
+      gzipMinLengthSet(false),
+      gzipCompLevel(GZIP_DEFAULT_LEVEL),
+      gzipCompLevelSet(false),
+      expires(EXPIRES_OFF),
+      expiresSet(false),
+      expiresByType(),
+      cacheControl(),
+      cacheControlByType(),
       indexes(),
       uploadDir(),
       cgiPass(),
@@ -20,6 +36,22 @@ LocationConfig::LocationConfig(const LocationConfig& other)
       root(other.root),
       autoIndex(other.autoIndex),
       autoIndexSet(other.autoIndexSet),
+      gzipStatic(other.gzipStatic),
+      gzipStaticSet(other.gzipStaticSet),
+      brotliStatic(other.brotliStatic),
+      brotliStaticSet(other.brotliStaticSet),
+      gzip(other.gzip),
+      gzipSet(other.gzipSet),
+      gzipTypes(other.gzipTypes),
+      gzipMinLength(other.gzipMinLength),
+      gzipMinLengthSet(other.gzipMinLengthSet),
+      gzipCompLevel(other.gzipCompLevel),
+      gzipCompLevelSet(other.gzipCompLevelSet),
+      expires(other.expires),
+      expiresSet(other.expiresSet),
+      expiresByType(other.expiresByType),
+      cacheControl(other.cacheControl),
+      cacheControlByType(other.cacheControlByType),
       indexes(other.indexes),
       uploadDir(other.uploadDir),
       cgiPass(other.cgiPass),
@@ -35,6 +67,22 @@ LocationConfig::LocationConfig(const String& p)
       root(),
       autoIndex(false),
       autoIndexSet(false),
+      gzipStatic(false),
+      gzipStaticSet(false),
+      brotliStatic(false),
+      brotliStaticSet(false),
+      gzip(false),
+      gzipSet(false),
+      gzipTypes(),
+      gzipMinLength(GZIP_MIN_LENGTH),
+      gzipMinLengthSet(false),
+      gzipCompLevel(GZIP_DEFAULT_LEVEL),
+      gzipCompLevelSet(false),
+      expires(EXPIRES_OFF),
+      expiresSet(false),
+      expiresByType(),
+      cacheControl(),
+      cacheControlByType(),
       indexes(),
       uploadDir(),
       cgiPass(),
@@ -47,19 +95,35 @@ LocationConfig::LocationConfig(const String& p)
 
 LocationConfig& LocationConfig::operator=(const LocationConfig& other) {
     if (this != &other) {
-        path           = other.path;
-        root           = other.root;
-        autoIndex      = other.autoIndex;
-        autoIndexSet   = other.autoIndexSet;
-        indexes        = other.indexes;
-        uploadDir      = other.uploadDir;
-        cgiPass        = other.cgiPass;
-        clientMaxBody  = other.clientMaxBody;
-        allowedMethods = other.allowedMethods;
-        errorPage      = other.errorPage;
-        hasRedirect    = other.hasRedirect;
-        redirectCode   = other.redirectCode;
-        redirectValue  = other.redirectValue;
+        path               = other.path;
+        root               = other.root;
+        autoIndex          = other.autoIndex;
+        autoIndexSet       = other.autoIndexSet;
+        gzipStatic         = other.gzipStatic;
+        gzipStaticSet      = other.gzipStaticSet;
+        brotliStatic       = other.brotliStatic;
+        brotliStaticSet    = other.brotliStaticSet;
+        gzip               = other.gzip;
+        gzipSet            = other.gzipSet;
+        gzipTypes          = other.gzipTypes;
+        gzipMinLength      = other.gzipMinLength;
+        gzipMinLengthSet   = other.gzipMinLengthSet;
+        gzipCompLevel      = other.gzipCompLevel;
+        gzipCompLevelSet   = other.gzipCompLevelSet;
+        expires            = other.expires;
+        expiresSet         = other.expiresSet;
+        expiresByType      = other.expiresByType;
+        cacheControl       = other.cacheControl;
+        cacheControlByType = other.cacheControlByType;
+        indexes            = other.indexes;
+        uploadDir          = other.uploadDir;
+        cgiPass            = other.cgiPass;
+        clientMaxBody      = other.clientMaxBody;
+        allowedMethods     = other.allowedMethods;
+        errorPage          = other.errorPage;
+        hasRedirect        = other.hasRedirect;
+        redirectCode       = other.redirectCode;
+        redirectValue      = other.redirectValue;
     }
     return *this;
 }
@@ -94,11 +158,150 @@ bool LocationConfig::setAutoIndex(const VectorString& v) {
     return true;
 }
 
+bool LocationConfig::setGzipStatic(const VectorString& v) {
+    if (gzipStaticSet)
+        return Logger::error("duplicate gzip_static directive");
+    if (!requireSingleValue(v, "gzip_static"))
+        return false;
+    if (v[0] != "on" && v[0] != "off")
+        return Logger::error("invalid gzip_static value (must be 'on' or 'off')");
+    gzipStatic    = (v[0] == "on");
+    gzipStaticSet = true;
+    return true;
+}
+
+bool LocationConfig::setBrotliStatic(const VectorString& v) {
+    if (brotliStaticSet)
+        return Logger::error("duplicate brotli_static directive");
+    if (!requireSingleValue(v, "brotli_static"))
+        return false;
+    if (v[0] != "on" && v[0] != "off")
+        return Logger::error("invalid brotli_static value (must be 'on' or 'off')");
+    brotliStatic    = (v[0] == "on");
+    brotliStaticSet = true;
+    return true;
+}
+
+bool LocationConfig::setGzip(const VectorString& v) {
+    if (gzipSet)
+        return Logger::error("duplicate gzip directive");
+    if (!requireSingleValue(v, "gzip"))
+        return false;
+    if (v[0] != "on" && v[0] != "off")
+        return Logger::error("invalid gzip value (must be 'on' or 'off')");
+    gzip    = (v[0] == "on");
+    gzipSet = true;
+    return true;
+}
+
+bool LocationConfig::setGzipTypes(const VectorString& v) {
+    if (!gzipTypes.empty())
+        return Logger::error("duplicate gzip_types directive");
+    if (v.empty())
+        return Logger::error("gzip_types requires at least one MIME type");
+    for (size_t i = 0; i < v.size(); ++i) {
+        if (v[i] != "*" && v[i].find('/') == String::npos)
+            return Logger::error("invalid gzip_types MIME type: " + v[i]);
+        gzipTypes.push_back(toLowerWords(v[i]));
+    }
+    return true;
+}
+
+bool LocationConfig::setGzipMinLength(const VectorString& v) {
+    if (gzipMinLengthSet)
+        return Logger::error("duplicate gzip_min_length directive");
+    if (!requireSingleValue(v, "gzip_min_length"))
+        return false;
+    if (!parseByteSize(v[0], gzipMinLength))
+        return Logger::error("invalid gzip_min_length value: " + v[0]);
+    gzipMinLengthSet = true;
+    return true;
+}
+
+bool LocationConfig::setGzipCompLevel(const VectorString& v) {
+    if (gzipCompLevelSet)
+        return Logger::error("duplicate gzip_comp_level directive");
+    if (!requireSingleValue(v, "gzip_comp_level"))
+        return false;
+    if (!stringToType<int>(v[0], gzipCompLevel) || gzipCompLevel < 1 || gzipCompLevel > 9)
+        return Logger::error("invalid gzip_comp_level value (must be 1-9): " + v[0]);
+    gzipCompLevelSet = true;
+    return true;
+}
+
 void LocationConfig::setAutoIndex(bool v) {
     autoIndex    = v;
     autoIndexSet = true;
 }
 
+// "off", "epoch", "max" or a time such as "30d".
+static bool parseExpires(const String& value, time_t& out) {
+    if (value == "off")
+        out = EXPIRES_OFF;
+    else if (value == "epoch")
+        out = EXPIRES_EPOCH;
+    else if (value == "max")
+        out = EXPIRES_MAX;
+    else
+        return parseSeconds(value, out);
+    return true;
+}
+
+static String joinWords(const VectorString& v, size_t from) {
+    String joined;
+    for (size_t i = from; i < v.size(); ++i) {
+        if (!joined.empty())
+            joined += " ";
+        joined += v[i];
+    }
+    return joined;
+}
+
+bool LocationConfig::setExpires(const VectorString& v) {
+    if (expiresSet)
+        return Logger::error("duplicate expires directive");
+    if (!requireSingleValue(v, "expires"))
+        return false;
+    if (!parseExpires(v[0], expires))
+        return Logger::error("invalid expires value (must be 'off', 'epoch', 'max' or a time): " + v[0]);
+    expiresSet = true;
+    return true;
+}
+
+bool LocationConfig::setExpiresByType(const VectorString& v) {
+    if (v.size() != 2)
+        return Logger::error("expires_by_type requires a MIME type and a time");
+    String type = toLowerWords(v[0]);
+    if (type.find('/') == String::npos)
+        return Logger::error("invalid expires_by_type MIME type: " + v[0]);
+    if (expiresByType.count(type))
+        return Logger::error("duplicate expires_by_type for " + type);
+    if (!parseExpires(v[1], expiresByType[type]))
+        return Logger::error("invalid expires_by_type value (must be 'off', 'epoch', 'max' or a time): " + v[1]);
+    return true;
+}
+
+bool LocationConfig::setCacheControl(const VectorString& v) {
+    if (!cacheControl.empty())
+        return Logger::error("duplicate cache_control directive");
+    if (v.empty())
+        return Logger::error("cache_control requires a value");
+    cacheControl = joinWords(v, 0);
+    return true;
+}
+
+bool LocationConfig::setCacheControlByType(const VectorString& v) {
+    if (v.size() < 2)
+        return Logger::error("cache_control_by_type requires a MIME type and a value");
+    String type = toLowerWords(v[0]);
+    if (type.find('/') == String::npos)
+        return Logger::error("invalid cache_control_by_type MIME type: " + v[0]);
+    if (cacheControlByType.count(type))
+        return Logger::error("duplicate cache_control_by_type for " + type);
+    cacheControlByType[type] = joinWords(v, 1);
+    return true;
+}
+
 bool LocationConfig::setIndexes(const VectorString& i) {
     if (!indexes.empty())
         return Logger::error("duplicate index");
@@ -245,6 +448,10 @@ VectorString LocationConfig::getIndexes() const {
     return indexes;
 }
 
+const MapIntString& LocationConfig::getErrorPages() const {
+    return errorPage;
+}
+
 String LocationConfig::getErrorPage(int code) const {
     std::map<int, String>::const_iterator it = errorPage.find(code);
     return (it != errorPage.end()) ? it->second : "";
@@ -260,4 +467,46 @@ int LocationConfig::getRedirectCode() const {
 
 String LocationConfig::getRedirectValue() const {
     return redirectValue;
-}
\ No newline at end of file
+}
+
+bool LocationConfig::getGzipStatic() const {
+    return gzipStatic;
+}
+
+bool LocationConfig::getBrotliStatic() const {
+    return brotliStatic;
+}
+
+bool LocationConfig::getGzip() const {
+    return gzip;
+}
+
+// Only text/html is compressed unless gzip_types says otherwise.
+bool LocationConfig::isGzipType(const String& mimeType) const {
+    if (gzipTypes.empty())
+        return mimeType == "text/html";
+    for (size_t i = 0; i < gzipTypes.size(); ++i)
+        if (gzipTypes[i] == "*" || gzipTypes[i] == mimeType)
+            return true;
+    return false;
+}
+
+size_t LocationConfig::getGzipMinLength() const {
+    return gzipMinLength;
+}
+
+int LocationConfig::getGzipCompLevel() const {
+    return gzipCompLevel;
+}
+
+// Lifetime for a response of mimeType: its expires_by_type entry, else the
+// location's expires.
+time_t LocationConfig::getExpires(const String& mimeType) const {
+    MapStringTime::const_iterator it = expiresByType.find(mimeType);
+    return it != expiresByType.end() ? it->second : expires;
+}
+
+String LocationConfig::getCacheControl(const String& mimeType) const {
+    MapString::const_iterator it = cacheControlByType.find(mimeType);
+    return it != cacheControlByType.end() ? it->second : cacheControl;
+}
@@ -18,6 +18,16 @@ class LocationConfig {
 
     void setAutoIndex(bool v);
     bool setAutoIndex(const VectorString& v);
+    bool setGzipStatic(const VectorString& v);
+    bool setBrotliStatic(const VectorString& v);
+    bool setGzip(const VectorString& v);
+    bool setGzipTypes(const VectorString& v);
+    bool setGzipMinLength(const VectorString& v);
+    bool setGzipCompLevel(const VectorString& v);
+    bool setExpires(const VectorString& v);
+    bool setExpiresByType(const VectorString& v);
+    bool setCacheControl(const VectorString& v);
+    bool setCacheControlByType(const VectorString& v);
 
     bool setIndexes(const VectorString& i);
     void setUploadDir(const String& p);
@@ -29,36 +39,61 @@ class LocationConfig {
     void setClientMaxBody(ssize_t c);
     bool setClientMaxBody(const VectorString& c);
 
-    bool             setAllowedMethods(const VectorString& m);
-    String           getPath() const;
-    String           getRoot() const;
-    bool             getAutoIndex() const;
-    VectorString     getIndexes() const;
-    String           getUploadDir() const;
-    const MapString& getCgiPass() const;
-    String           getCgiInterpreter(const String& extension) const;
-    bool             hasCgi() const;
-    ssize_t          getClientMaxBody() const;
-    VectorString     getAllowedMethods() const;
-    String           getErrorPage(int code) const;
-    bool             getIsRedirect() const;
-    int              getRedirectCode() const;
-    String           getRedirectValue() const;
+    bool                setAllowedMethods(const VectorString& m);
+    String              getPath() const;
+    String              getRoot() const;
+    bool                getAutoIndex() const;
+    bool                getGzipStatic() const;
+    bool                getBrotliStatic() const;
+    bool                getGzip() const;
+    bool                isGzipType(const String& mimeType) const;
+    size_t              getGzipMinLength() const;
+    int                 getGzipCompLevel() const;
+    time_t              getExpires(const String& mimeType) const;
+    String              getCacheControl(const String& mimeType) const;
+    VectorString        getIndexes() const;
+    String              getUploadDir() const;
+    const MapString&    getCgiPass() const;
+    String              getCgiInterpreter(const String& extension) const;
+    bool                hasCgi() const;
+    ssize_t             getClientMaxBody() const;
+    VectorString        getAllowedMethods() const;
+    const MapIntString& getErrorPages() const;
+    String              getErrorPage(int code) const;
+    bool                getIsRedirect() const;
+    int                 getRedirectCode() const;
+    String              getRedirectValue() const;
 
    private:
-    String path;
-    String       root;           // default root of server if not set (be required)
-    bool         autoIndex;      // default: false
-    bool         autoIndexSet;   // tracks if autoindex directive was used
-    VectorString indexes;        // default: root if not set be default "index.html"
-    String       uploadDir;      // upload directory path
-    MapString    cgiPass;        // maps extension to interpreter path
-    ssize_t      clientMaxBody;  // default: ""
-    VectorString allowedMethods; // default: GET
-    MapIntString errorPage;      // maps error code to error page path
-    bool         hasRedirect;
-    int          redirectCode;
-    String       redirectValue;
+    String        path;
+    String        root;               // default root of server if not set (be required)
+    bool          autoIndex;          // default: false
+    bool          autoIndexSet;       // tracks if autoindex directive was used
+    bool          gzipStatic;         // default: false; serve "<file>.gz" when accepted
+    bool          gzipStaticSet;      // tracks if gzip_static directive was used
+    bool          brotliStatic;       // default: false; serve "<file>.br" when accepted
+    bool          brotliStaticSet;    // tracks if brotli_static directive was used
+    bool          gzip;               // default: false; compress generated responses
+    bool          gzipSet;            // tracks if gzip directive was used
+    VectorString  gzipTypes;          // default: text/html
+    size_t        gzipMinLength;      // default: GZIP_MIN_LENGTH bytes
+    bool          gzipMinLengthSet;   // tracks if gzip_min_length directive was used
+    int           gzipCompLevel;      // default: GZIP_DEFAULT_LEVEL
+    bool          gzipCompLevelSet;   // tracks if gzip_comp_level directive was used
+    time_t        expires;            // default: EXPIRES_OFF; seconds or EXPIRES_EPOCH
+    bool          expiresSet;         // tracks if expires directive was used
+    MapStringTime expiresByType;      // expires_by_type overrides
+    String        cacheControl;       // default: derived from expires
+    MapString     cacheControlByType; // cache_control_by_type overrides
+    VectorString  indexes;            // default: root if not set be default "index.html"
+    String        uploadDir;          // upload directory path
+    MapString     cgiPass;            // maps extension to interpreter path
+    ssize_t       clientMaxBody;      // default: ""
+    VectorString  allowedMethods;     // default: GET
+    MapIntString  errorPage;          // maps error code to error page path
+    bool          hasRedirect;
+    int           redirectCode;
+    String        redirectValue;
 };
 
 #endif
\ No newline at end of file
@@ -155,7 +155,7 @@ VectorString CgiHandler::buildEnv(const RouteResult& resultRouter) const {
 
     env.push_back("GATEWAY_INTERFACE=" + String(CGI_INTERFACE));
     env.push_back("SERVER_NAME=" + resultRouter.getServer()->getServerName());
-    env.push_back("SERVER_SOFTWARE=Webserv/1.0");
+    env.push_back("SERVER_SOFTWARE=" SERVER_SOFTWARE);
     env.push_back("SERVER_PORT=" + typeToString<int>(req.getPort()));
     env.push_back("SERVER_PROTOCOL=" + req.getHttpVersion());
     env.push_back("REQUEST_METHOD=" + req.getMethod());
@@ -66,6 +66,11 @@ void CgiProcess::reset() {
     _totalBytesReceived = 0;
 }
 
+void CgiProcess::releaseBuffers(size_t maxCapacity) {
+    releaseIfLarger(_writeBuffer, maxCapacity);
+    releaseIfLarger(_output, maxCapacity);
+}
+
 bool CgiProcess::isActive() const { return _active; }
 pid_t CgiProcess::getPid() const { return _pid; }
 int CgiProcess::getWriteFd() const { return _writeFd; }
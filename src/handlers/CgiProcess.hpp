@@ -30,6 +30,7 @@ class CgiProcess {
     void          init(pid_t pid, int writeFd, int readFd);
     void          appendBuffer(const char* data, size_t len);
     void          reset();
+    void          releaseBuffers(size_t maxCapacity);
     bool          isActive() const;
     pid_t         getPid() const;
     int           getWriteFd() const;
@@ -6,7 +6,7 @@
 #include "../http/HttpResponse.hpp"
 #include "../utils/Logger.hpp"
 #include "../utils/Utils.hpp"
-#include "FileHandler.hpp"
+#include "DirectoryListingSource.hpp"
 #include "IHandler.hpp"
 
 class DirectoryListingHandler : public IHandler {
@@ -19,8 +19,7 @@ class DirectoryListingHandler : public IHandler {
     bool handle(const RouteResult& resultRouter, HttpResponse& response) const;
 
    private:
-    String buildRow(const FileHandler& fileInfo) const;
-    bool   readDirectoryEntries(const String& path, const String& uri, std::vector<FileHandler>& entries) const;
+    bool readDirectoryEntries(const String& path, VectorString& names) const;
 };
 
 #endif
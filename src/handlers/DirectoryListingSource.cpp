@@ -0,0 +1,95 @@
+#include "DirectoryListingSource.hpp"
+
+DirectoryListingSource::DirectoryListingSource(const String& _path, const String& _uri, const VectorString& _names, bool chunked)
+    : GeneratorBodySource(chunked), path(_path), uri(_uri), names(_names), next(0), headSent(false) {}
+
+DirectoryListingSource::DirectoryListingSource(const DirectoryListingSource& other)
+    : GeneratorBodySource(other), path(other.path), uri(other.uri), names(other.names), next(other.next), headSent(other.headSent) {}
+
+DirectoryListingSource::~DirectoryListingSource() {}
+
+IBodySource* DirectoryListingSource::clone() const {
+    return new DirectoryListingSource(*this);
+}
+
+String DirectoryListingSource::buildRow(const FileHandler& fileInfo) {
+    return "<tr class=\"row\">\n"
+           "<td class=\"icon\"><img src=\"" +
+           fileInfo.getIcon() +
+           "\"/></td>\n"
+           "<td class=\"name\"><a href=\"" +
+           fileInfo.getFileLink() + "\">" + fileInfo.getFileName() +
+           "</a></td>\n"
+           "<td class=\"date\">" +
+           fileInfo.getLastModifiedDate() +
+           "</td>\n"
+           "<td class=\"size\">" +
+           fileInfo.getSize() +
+           "</td>\n"
+           "<td></td>\n"
+           "</tr>\n";
+}
+
+// The navigation rows ("Go To Parent" / "Back") go out with the page head.
+void DirectoryListingSource::renderHead(String& out) const {
+    String pageUri = uri;
+    if (pageUri.size() > 1 && pageUri[pageUri.size() - 1] == '/')
+        pageUri = pageUri.substr(0, pageUri.size() - 1);
+    pageUri = htmlEntities(pageUri);
+    out +=
+        "<!DOCTYPE html>\n"
+        "<html lang=\"en\">\n"
+        "<head>\n"
+        "<meta charset=\"UTF-8\">\n"
+        "<meta name=\"viewport\" content=\"width=device-width, initial-scale=1\">\n"
+        "<title>Index of " +
+        pageUri +
+        "</title>\n"
+        "<style>\n"
+        "body{font-family:system-ui;background:#0f172a;color:#e2e8f0;margin:0;padding:40px;}\n"
+        "h1{font-weight:600;margin-bottom:20px;}\n"
+        "table{width:100%;border-collapse:collapse;background:#020617;border-radius:12px;overflow:hidden;}\n"
+        "thead{background:#020617;}\n"
+        "th{font-size:13px;text-align:left;padding:14px;color:#94a3b8;border-bottom:1px solid #1e293b;}\n"
+        "td{padding:14px;border-bottom:1px solid #0f172a;}\n"
+        ".row:hover{background:#020617;}\n"
+        ".icon img{width:20px;height:20px;}\n"
+        ".name a{color:#38bdf8;text-decoration:none;font-weight:500;}\n"
+        ".name a:hover{text-decoration:underline;}\n"
+        "</style>\n"
+        "</head>\n"
+        "<body>\n"
+        "<h1>Index of " +
+        pageUri +
+        "</h1>\n"
+        "<table>\n"
+        "<thead>\n"
+        "<tr>\n"
+        "<th style=\"width:40px\"></th>\n"
+        "<th>Name</th>\n"
+        "<th>Last Modified</th>\n"
+        "<th>Size</th>\n"
+        "<th></th>\n"
+        "</tr>\n"
+        "</thead>\n"
+        "<tbody>\n";
+    FileHandler self(NULL, ".", uri);
+    FileHandler parent(NULL, "..", uri);
+    if (!self.getFileName().empty())
+        out += buildRow(self);
+    if (!parent.getFileName().empty())
+        out += buildRow(parent);
+}
+
+bool DirectoryListingSource::produce(String& out) {
+    if (!headSent) {
+        renderHead(out);
+        headSent = true;
+    }
+    while (next < names.size() && out.size() < BUFFER_SIZE)
+        out += buildRow(FileHandler(names[next++], path));
+    if (next < names.size())
+        return true;
+    out += "</tbody>\n</table>\n</body>\n</html>";
+    return false;
+}
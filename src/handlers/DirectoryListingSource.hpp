@@ -0,0 +1,36 @@
+#ifndef DIRECTORY_LISTING_SOURCE_HPP
+#define DIRECTORY_LISTING_SOURCE_HPP
+
+#include "../http/GeneratorBodySource.hpp"
+#include "../utils/Utils.hpp"
+#include "FileHandler.hpp"
+
+// Renders an autoindex page row by row. Entries are only named up front;
+// each one is stat()ed when its row is produced, so large directories
+// start streaming immediately.
+class DirectoryListingSource : public GeneratorBodySource {
+   public:
+    DirectoryListingSource(const String& path, const String& uri, const VectorString& names, bool chunked);
+    DirectoryListingSource(const DirectoryListingSource& other);
+    ~DirectoryListingSource();
+
+    IBodySource* clone() const;
+
+   protected:
+    bool produce(String& out);
+
+   private:
+    DirectoryListingSource();
+    DirectoryListingSource& operator=(const DirectoryListingSource& other);
+
+    static String buildRow(const FileHandler& fileInfo);
+    void          renderHead(String& out) const;
+
+    String       path;
+    String       uri;
+    VectorString names;
+    size_t       next;
+    bool         headSent;
+};
+
+#endif
@@ -15,8 +15,17 @@ FileHandler::FileHandler(struct dirent* entry, const String& basePath, String pa
                                : "https://cdn-icons-png.flaticon.com/512/7945/7945195.png";
         return;
     }
-    String fileName = entry->d_name;
+    describe(entry->d_name, basePath);
+}
+
+// Entry read lazily by name (streamed directory listings stat each row only
+// when it is rendered).
+FileHandler::FileHandler(const String& fileName, const String& basePath)
+    : name(), link(), icon(), size("-"), lastModified() {
+    describe(fileName, basePath);
+}
 
+void FileHandler::describe(const String& fileName, const String& basePath) {
     name             = htmlEntities(fileName);
     link             = htmlEntities(fileName);
     icon             = "https://cdn-icons-png.flaticon.com/512/9166/9166568.png"; // UNKnown
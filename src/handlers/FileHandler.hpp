@@ -6,6 +6,7 @@ class FileHandler {
    public:
     FileHandler();
     FileHandler(struct dirent* entry, const String& basePath, String pathUri);
+    FileHandler(const String& fileName, const String& basePath);
     FileHandler(const FileHandler& other);
     FileHandler& operator=(const FileHandler& other);
     ~FileHandler();
@@ -17,6 +18,8 @@ class FileHandler {
     const String& getLastModifiedDate() const;
 
    private:
+    void describe(const String& fileName, const String& basePath);
+
     String name;
     String link;
     String icon;
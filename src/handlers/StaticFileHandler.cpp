@@ -1,30 +1,244 @@
 #include "StaticFileHandler.hpp"
+#include <cctype>
+#include "../http/MultipartRangeSource.hpp"
 
-StaticFileHandler::StaticFileHandler() : mimeTypes() {}
+StaticFileHandler::StaticFileHandler() : mimeTypes(), fileCache(NULL) {}
 
-StaticFileHandler::StaticFileHandler(const MimeTypes& _mimeTypes) : mimeTypes(_mimeTypes) {}
+StaticFileHandler::StaticFileHandler(const MimeTypes& _mimeTypes, OpenFileCache* _fileCache)
+    : mimeTypes(_mimeTypes), fileCache(_fileCache) {}
 
-StaticFileHandler::StaticFileHandler(const StaticFileHandler& other) : mimeTypes(other.mimeTypes) {}
+StaticFileHandler::StaticFileHandler(const StaticFileHandler& other) : mimeTypes(other.mimeTypes), fileCache(other.fileCache) {}
 
 StaticFileHandler& StaticFileHandler::operator=(const StaticFileHandler& other) {
     if (this != &other) {
         mimeTypes = other.mimeTypes;
+        fileCache = other.fileCache;
     }
     return *this;
 }
 
 StaticFileHandler::~StaticFileHandler() {}
 
+// Metadata of the regular file at path and, when wantFd is set, an fd the
+// caller owns. A cache hit costs one dup() and no path lookup.
+bool StaticFileHandler::openFile(const String& path, bool wantFd, int& fd, CachedFile& info) const {
+    fd = INVALID_FD;
+    if (fileCache && fileCache->isEnabled()) {
+        const CachedFile* file = fileCache->lookup(path, getCurrentTime());
+        if (!file || file->type != SINGLEFILE || file->fd == INVALID_FD)
+            return false;
+        info = *file;
+        if (wantFd && (fd = dup(file->fd)) < 0)
+            return false;
+        return true;
+    }
+    int opened = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (opened < 0)
+        return false;
+    struct stat st;
+    if (fstat(opened, &st) != 0 || !S_ISREG(st.st_mode)) {
+        close(opened);
+        return false;
+    }
+    info.type   = SINGLEFILE;
+    info.size   = st.st_size;
+    info.mtime  = st.st_mtime;
+    info.inode  = st.st_ino;
+    info.device = st.st_dev;
+    if (wantFd)
+        fd = opened;
+    else
+        close(opened);
+    return true;
+}
+
+// gzip_static/brotli_static: the "<file>.br" or "<file>.gz" sidecar when the
+// location enables it and the client accepts that coding, br first.
+bool StaticFileHandler::openPrecompressed(const RouteResult& resultRouter, bool wantFd, int& fd, CachedFile& info, String& encoding) const {
+    const LocationConfig* loc = resultRouter.getLocation();
+    if (!loc)
+        return false;
+    String accept = resultRouter.getRequest().getHeader(FIELD_ACCEPT_ENCODING);
+    if (accept.empty())
+        return false;
+    const String& path = resultRouter.getPathRootUri();
+    if (loc->getBrotliStatic() && acceptsEncoding(accept, "br") && openFile(path + ".br", wantFd, fd, info)) {
+        encoding = "br";
+        return true;
+    }
+    if (loc->getGzipStatic() && acceptsEncoding(accept, "gzip") && openFile(path + ".gz", wantFd, fd, info)) {
+        encoding = "gzip";
+        return true;
+    }
+    return false;
+}
+
+bool StaticFileHandler::openRepresentation(const RouteResult& resultRouter, bool wantFd, int& fd, CachedFile& info, String& encoding) const {
+    encoding.clear();
+    return openPrecompressed(resultRouter, wantFd, fd, info, encoding) || openFile(resultRouter.getPathRootUri(), wantFd, fd, info);
+}
+
+// If-None-Match wins over If-Modified-Since; both only apply to GET/HEAD.
+static bool isNotModified(const HttpRequest& request, const String& etag, time_t mtime) {
+    const String& method = request.getMethod();
+    if (method != "GET" && method != "HEAD")
+        return false;
+    String ifNoneMatch = request.getHeader(FIELD_IF_NONE_MATCH);
+    if (!ifNoneMatch.empty())
+        return matchesEntityTag(ifNoneMatch, etag);
+    time_t since;
+    return parseHttpDate(request.getHeader(FIELD_IF_MODIFIED_SINCE), since) && mtime <= since;
+}
+
+typedef std::pair<off_t, off_t> ByteRange; // first and last byte, inclusive
+
+// Plain digits only; signs and spaces make the range set invalid.
+static bool parseBytePos(const String& s, off_t& out) {
+    if (s.empty() || s.size() > 18)
+        return false;
+    out = 0;
+    for (size_t i = 0; i < s.size(); ++i) {
+        if (!std::isdigit(static_cast<unsigned char>(s[i])))
+            return false;
+        out = out * 10 + (s[i] - '0');
+    }
+    return true;
+}
+
+// "bytes=0-99, 200-, -50". A malformed set returns false and the header is
+// ignored; ranges starting past the end are dropped, so an empty result
+// means 416. Sets larger than MAX_BYTE_RANGES are ignored as well.
+static bool parseRanges(const String& header, off_t size, std::vector<ByteRange>& ranges) {
+    if (header.compare(0, 6, "bytes=") != 0)
+        return false;
+    VectorString specs;
+    splitByString(header.substr(6), specs, ",");
+    if (specs.size() > MAX_BYTE_RANGES)
+        return false;
+    for (size_t i = 0; i < specs.size(); ++i) {
+        String spec = trimSpaces(specs[i]);
+        size_t dash = spec.find('-');
+        if (spec.empty())
+            continue;
+        if (dash == String::npos)
+            return false;
+        String first = spec.substr(0, dash);
+        String last  = spec.substr(dash + 1);
+        off_t  from;
+        off_t  to;
+        if (first.empty()) {
+            if (!parseBytePos(last, to))
+                return false;
+            if (to == 0 || size == 0)
+                continue;
+            from = to >= size ? 0 : size - to;
+            to   = size - 1;
+        } else {
+            if (!parseBytePos(first, from))
+                return false;
+            if (last.empty())
+                to = size - 1;
+            else if (!parseBytePos(last, to) || to < from)
+                return false;
+            if (from >= size)
+                continue;
+            if (to >= size)
+                to = size - 1;
+        }
+        ranges.push_back(ByteRange(from, to));
+    }
+    return true;
+}
+
+// Range only applies to GET, and with If-Range only while the file still
+// has that exact (strong) ETag or Last-Modified date.
+static bool selectRanges(const HttpRequest& request, const CachedFile& info, std::vector<ByteRange>& ranges) {
+    String range = request.getHeader(FIELD_RANGE);
+    if (range.empty() || request.getMethod() != "GET")
+        return false;
+    String ifRange = trimSpaces(request.getHeader(FIELD_IF_RANGE));
+    if (!ifRange.empty()) {
+        time_t date;
+        if (ifRange[0] == '"' ? ifRange != HttpResponse::entityTag(info.size, info.mtime, info.inode)
+                              : !parseHttpDate(ifRange, date) || date != info.mtime)
+            return false;
+    }
+    return parseRanges(range, info.size, ranges);
+}
+
+// 206 with one range streamed straight from its file offset, or a
+// multipart/byteranges body for several; 416 when none is satisfiable.
+static void setRangeBody(HttpResponse& response, int fd, const CachedFile& info, const String& type, const std::vector<ByteRange>& ranges) {
+    String total = typeToString<off_t>(info.size);
+    if (ranges.empty()) {
+        if (fd != INVALID_FD)
+            close(fd);
+        response.setStatus(HTTP_RANGE_NOT_SATISFIABLE, getHttpStatusMessage(HTTP_RANGE_NOT_SATISFIABLE));
+        response.addHeader(HEADER_CONTENT_RANGE, "bytes */" + total);
+        response.addHeader(HEADER_CONTENT_LENGTH, "0");
+        return;
+    }
+    response.setStatus(HTTP_PARTIAL_CONTENT, getHttpStatusMessage(HTTP_PARTIAL_CONTENT));
+    if (ranges.size() == 1) {
+        size_t length = static_cast<size_t>(ranges[0].second - ranges[0].first + 1);
+        response.setResponseHeaders(type, length);
+        response.addHeader(HEADER_CONTENT_RANGE, "bytes " + typeToString<off_t>(ranges[0].first) + "-" +
+                                                     typeToString<off_t>(ranges[0].second) + "/" + total);
+        response.setBodyFile(fd, ranges[0].first, length);
+        return;
+    }
+    String                boundary = generateGUID();
+    MultipartRangeSource* source   = new MultipartRangeSource(fd, boundary, type, info.size);
+    for (size_t i = 0; i < ranges.size(); ++i)
+        source->addRange(ranges[i].first, ranges[i].second);
+    source->finish();
+    response.setResponseHeaders("multipart/byteranges; boundary=" + boundary, source->getLength());
+    response.setBodySource(source);
+}
+
+// The body is not read here: the open fd travels with the response as a
+// FileBodySource and the client streams it with sendfile(), so memory per
+// download stays constant. Conditional requests are first answered from
+// metadata alone, so a 304 never opens an fd for the body.
 bool StaticFileHandler::handle(const RouteResult& resultRouter, HttpResponse& response) const {
-    String path   = resultRouter.getPathRootUri();
-    String method = resultRouter.getRequest().getMethod();
-    String content;
-    if (!readFileContent(path, content))
+    const HttpRequest&    request     = resultRouter.getRequest();
+    bool                  wantFd      = request.getMethod() != "HEAD";
+    bool                  conditional = request.hasHeader(FIELD_IF_NONE_MATCH) || request.hasHeader(FIELD_IF_MODIFIED_SINCE);
+    const LocationConfig* loc         = resultRouter.getLocation();
+    int                   fd;
+    CachedFile            info = CachedFile();
+    String                encoding;
+    if (!openRepresentation(resultRouter, wantFd && !conditional, fd, info, encoding))
         return false;
-    response.setStatus(HTTP_OK, "OK");
-    response.setResponseHeaders(mimeTypes.get(path), content.size());
-    if (method != "HEAD") {
-        response.setBody(content);
+    String type = mimeTypes.get(resultRouter.getPathRootUri());
+    if (loc)
+        response.setCacheHeaders(loc->getExpires(type), loc->getCacheControl(type));
+    if (conditional && isNotModified(request, HttpResponse::entityTag(info.size, info.mtime, info.inode), info.mtime)) {
+        response.setStatus(HTTP_NOT_MODIFIED, getHttpStatusMessage(HTTP_NOT_MODIFIED));
+        response.setValidators(info.size, info.mtime, info.inode);
+        if (loc && (loc->getGzipStatic() || loc->getBrotliStatic()))
+            response.addHeader(HEADER_VARY, HEADER_ACCEPT_ENCODING);
+        return true;
     }
+    if (conditional && wantFd && !openRepresentation(resultRouter, true, fd, info, encoding))
+        return false;
+    std::vector<ByteRange> ranges;
+    response.setValidators(info.size, info.mtime, info.inode);
+    response.addHeader(HEADER_ACCEPT_RANGES, "bytes");
+    if (!encoding.empty())
+        response.addHeader(HEADER_CONTENT_ENCODING, encoding);
+    if (loc && (loc->getGzipStatic() || loc->getBrotliStatic()))
+        response.addHeader(HEADER_VARY, HEADER_ACCEPT_ENCODING);
+    if (fd != INVALID_FD && selectRanges(request, info, ranges)) {
+        setRangeBody(response, fd, info, type, ranges);
+        return true;
+    }
+    size_t size = static_cast<size_t>(info.size);
+    response.setStatus(HTTP_OK, "OK");
+    response.setResponseHeaders(type, size);
+    if (size == 0 && fd != INVALID_FD)
+        close(fd);
+    else if (fd != INVALID_FD)
+        response.setBodyFile(fd, 0, size);
     return true;
 }
@@ -3,6 +3,7 @@
 #include "../config/MimeTypes.hpp"
 #include "../http/HttpResponse.hpp"
 #include "../http/RouteResult.hpp"
+#include "../utils/OpenFileCache.hpp"
 #include "../utils/Utils.hpp"
 #include "IHandler.hpp"
 
@@ -11,13 +12,18 @@ class StaticFileHandler : public IHandler {
     StaticFileHandler();
     StaticFileHandler(const StaticFileHandler& other);
     StaticFileHandler& operator=(const StaticFileHandler& other);
-    StaticFileHandler(const MimeTypes& mimeTypes);
+    StaticFileHandler(const MimeTypes& mimeTypes, OpenFileCache* fileCache = NULL);
     ~StaticFileHandler();
 
     bool handle(const RouteResult& resultRouter, HttpResponse& response) const;
 
    private:
-    MimeTypes mimeTypes;
+    MimeTypes      mimeTypes;
+    OpenFileCache* fileCache;
+
+    bool openFile(const String& path, bool wantFd, int& fd, CachedFile& info) const;
+    bool openPrecompressed(const RouteResult& resultRouter, bool wantFd, int& fd, CachedFile& info, String& encoding) const;
+    bool openRepresentation(const RouteResult& resultRouter, bool wantFd, int& fd, CachedFile& info, String& encoding) const;
 };
 
 #endif
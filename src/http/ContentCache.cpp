@@ -0,0 +1,156 @@
+#include "ContentCache.hpp"
+#include "HttpResponse.hpp"
+
+ContentCache::ContentCache()
+    : maxBytes(0), maxFileSize(0), bytes(0), hits(0), misses(0), mimeTypes(), fileCache(NULL), entries(), lru() {}
+
+ContentCache::~ContentCache() {}
+
+void ContentCache::configure(size_t _maxBytes, size_t _maxFileSize, const MimeTypes& _mimeTypes, OpenFileCache* _fileCache) {
+    clear();
+    maxBytes    = _maxBytes;
+    maxFileSize = _maxFileSize;
+    mimeTypes   = _mimeTypes;
+    fileCache   = _fileCache;
+}
+
+bool ContentCache::isEnabled() const {
+    return maxBytes > 0;
+}
+
+// Current metadata of path: from the open file cache when it is enabled,
+// otherwise one stat().
+bool ContentCache::statFile(const String& path, time_t now, struct stat& st) {
+    if (fileCache && fileCache->isEnabled()) {
+        const CachedFile* file = fileCache->lookup(path, now);
+        if (!file || file->type != SINGLEFILE)
+            return false;
+        st.st_mode  = S_IFREG;
+        st.st_size  = file->size;
+        st.st_mtime = file->mtime;
+        st.st_ino   = file->inode;
+        st.st_dev   = file->device;
+        return true;
+    }
+    return stat(path.c_str(), &st) == 0 && S_ISREG(st.st_mode);
+}
+
+// Reads the file and renders the response StaticFileHandler would build for
+// it. Fails when the file changed since `st` was taken.
+bool ContentCache::load(const String& path, const struct stat& st, CachedContent& content) const {
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        return false;
+    struct stat now;
+    if (fstat(fd, &now) != 0 || now.st_size != st.st_size || now.st_mtime != st.st_mtime || now.st_ino != st.st_ino) {
+        close(fd);
+        return false;
+    }
+    String body(static_cast<size_t>(st.st_size), '\0');
+    size_t done = 0;
+    while (done < body.size()) {
+        ssize_t n = read(fd, &body[done], body.size() - done);
+        if (n <= 0)
+            break;
+        done += static_cast<size_t>(n);
+    }
+    close(fd);
+    if (done != body.size())
+        return false;
+
+    HttpResponse response;
+    response.setStatus(HTTP_OK, "OK");
+    content.status = HTTP_OK;
+    content.type   = mimeTypes.get(path);
+    response.setResponseHeaders(content.type, body.size());
+    response.setValidators(st.st_size, st.st_mtime, st.st_ino);
+    response.addHeader(HEADER_ACCEPT_RANGES, "bytes");
+    content.wire.clear();
+    response.appendHeaders(content.wire);
+    content.wire.append(CRLF);
+    content.headLength = content.wire.size();
+    content.wire.append(body);
+    content.size   = st.st_size;
+    content.mtime  = st.st_mtime;
+    content.inode  = st.st_ino;
+    content.device = st.st_dev;
+    return true;
+}
+
+size_t ContentCache::cost(const String& path, const CachedContent& content) const {
+    return path.size() + content.wire.size();
+}
+
+void ContentCache::erase(EntryMap::iterator it) {
+    bytes -= cost(it->first, it->second.content);
+    lru.erase(it->second.lru);
+    entries.erase(it);
+}
+
+// The cached response for path, loading it on a miss when the file fits,
+// or NULL when it must be served by StaticFileHandler. The pointer is valid
+// until the next call.
+const CachedContent* ContentCache::lookup(const String& path, time_t now) {
+    if (!isEnabled())
+        return NULL;
+    struct stat        st;
+    EntryMap::iterator it = entries.find(path);
+    if (!statFile(path, now, st)) {
+        if (it != entries.end())
+            erase(it);
+        ++misses;
+        return NULL;
+    }
+    if (it != entries.end()) {
+        const CachedContent& cached = it->second.content;
+        if (cached.size == st.st_size && cached.mtime == st.st_mtime && cached.inode == st.st_ino && cached.device == st.st_dev) {
+            ++hits;
+            lru.splice(lru.begin(), lru, it->second.lru);
+            return &cached;
+        }
+        erase(it);
+    }
+    ++misses;
+    if (static_cast<size_t>(st.st_size) > maxFileSize)
+        return NULL;
+    CachedContent content;
+    if (!load(path, st, content) || cost(path, content) > maxBytes)
+        return NULL;
+    while (bytes + cost(path, content) > maxBytes && !lru.empty())
+        erase(entries.find(lru.back()));
+    lru.push_front(path);
+    Entry& entry = entries[path];
+    entry.content.wire.swap(content.wire);
+    entry.content.status     = content.status;
+    entry.content.headLength = content.headLength;
+    entry.content.type       = content.type;
+    entry.content.size       = content.size;
+    entry.content.mtime      = content.mtime;
+    entry.content.inode      = content.inode;
+    entry.content.device     = content.device;
+    entry.lru                = lru.begin();
+    bytes += cost(path, entry.content);
+    return &entry.content;
+}
+
+void ContentCache::clear() {
+    entries.clear();
+    lru.clear();
+    bytes = 0;
+}
+
+size_t ContentCache::size() const {
+    return entries.size();
+}
+
+size_t ContentCache::getBytes() const {
+    return bytes;
+}
+
+size_t ContentCache::getHits() const {
+    return hits;
+}
+
+size_t ContentCache::getMisses() const {
+    return misses;
+}
@@ -0,0 +1,76 @@
+#ifndef CONTENT_CACHE_HPP
+#define CONTENT_CACHE_HPP
+
+#include <sys/stat.h>
+#include <list>
+#include <map>
+#include "../config/MimeTypes.hpp"
+#include "../utils/OpenFileCache.hpp"
+#include "../utils/Utils.hpp"
+
+// A small static file kept as its serialized 200 response: the header lines
+// after Date/Server/Connection, the blank line, then the body.
+struct CachedContent {
+    int    status;
+    String wire;
+    size_t headLength; // bytes of `wire` sent for HEAD
+    String type;       // for expires_by_type/cache_control_by_type
+    off_t  size;
+    time_t mtime;
+    ino_t  inode;
+    dev_t  device;
+};
+
+// content_cache: hot small files held in memory within a byte budget and
+// evicted LRU-first. An entry is checked against the file's size, mtime and
+// inode on every hit. Without open_file_cache that is a fresh stat(), so
+// edits on disk are never served stale. With it, the metadata comes from
+// the open file cache and a hit costs no syscall, but an edit is only seen
+// once that entry is revalidated, up to open_file_cache_valid later, the
+// same delay static files served through the open file cache have.
+//
+// One cache per event loop, like OpenFileCache: no lock, and the budget
+// applies to each loop separately.
+class ContentCache {
+   public:
+    ContentCache();
+    ~ContentCache();
+
+    void                 configure(size_t maxBytes, size_t maxFileSize, const MimeTypes& mimeTypes, OpenFileCache* fileCache);
+    bool                 isEnabled() const;
+    const CachedContent* lookup(const String& path, time_t now);
+    void                 clear();
+    size_t               size() const;
+    size_t               getBytes() const;
+    size_t               getHits() const;
+    size_t               getMisses() const;
+
+   private:
+    typedef std::list<String> LruList;
+
+    struct Entry {
+        CachedContent     content;
+        LruList::iterator lru;
+    };
+    typedef std::map<String, Entry> EntryMap;
+
+    ContentCache(const ContentCache&);
+    ContentCache& operator=(const ContentCache&);
+
+    bool   statFile(const String& path, time_t now, struct stat& st);
+    bool   load(const String& path, const struct stat& st, CachedContent& content) const;
+    size_t cost(const String& path, const CachedContent& content) const;
+    void   erase(EntryMap::iterator it);
+
+    size_t         maxBytes;
+    size_t         maxFileSize;
+    size_t         bytes;
+    size_t         hits;
+    size_t         misses;
+    MimeTypes      mimeTypes;
+    OpenFileCache* fileCache; // owned by the event loop, may be NULL
+    EntryMap       entries;
+    LruList        lru; // most recently used first
+};
+
+#endif
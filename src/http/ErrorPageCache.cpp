@@ -0,0 +1,82 @@
+#include "ErrorPageCache.hpp"
+#include "../handlers/ErrorPageHandler.hpp"
+#include "HttpResponse.hpp"
+
+ErrorPageCache::ErrorPageCache() : pages() {}
+
+ErrorPageCache::ErrorPageCache(const ErrorPageCache& other) : pages(other.pages) {}
+
+ErrorPageCache& ErrorPageCache::operator=(const ErrorPageCache& other) {
+    if (this != &other)
+        pages = other.pages;
+    return *this;
+}
+
+ErrorPageCache::~ErrorPageCache() {}
+
+// Same response ErrorPageHandler builds. An unreadable error_page file is
+// skipped, so lookups fall back to the built-in page as the handler does.
+void ErrorPageCache::render(const String& path, int code, const MimeTypes& mimeTypes) {
+    PageKey key(path, code);
+    if (pages.count(key))
+        return;
+    String body;
+    String type = "text/html";
+    if (path.empty())
+        body = ErrorPageHandler().generateHtml(code, getHttpStatusMessage(code));
+    else if (readFileContent(path, body))
+        type = mimeTypes.get(path);
+    else {
+        Logger::error("error_page " + path + " is not readable; using the built-in page");
+        return;
+    }
+
+    HttpResponse response;
+    response.setStatus(code, getHttpStatusMessage(code));
+    response.setResponseHeaders(type, body.size());
+    CachedContent& content = pages[key];
+    response.appendHeaders(content.wire);
+    content.wire.append(CRLF);
+    content.headLength = content.wire.size();
+    content.wire.append(body);
+    content.status = code;
+    content.type   = type;
+    content.size   = static_cast<off_t>(body.size());
+    content.mtime  = 0;
+    content.inode  = 0;
+    content.device = 0;
+}
+
+void ErrorPageCache::renderAll(const MapIntString& errorPages, const MimeTypes& mimeTypes) {
+    for (MapIntString::const_iterator it = errorPages.begin(); it != errorPages.end(); ++it)
+        render(it->second, it->first, mimeTypes);
+}
+
+void ErrorPageCache::build(const VectorServerConfig& servers, const MimeTypes& mimeTypes) {
+    pages.clear();
+    for (int code = HTTP_BAD_REQUEST; code < 600; ++code)
+        if (getHttpStatusMessage(code) != "Unknown Error")
+            render("", code, mimeTypes);
+    for (size_t i = 0; i < servers.size(); ++i) {
+        renderAll(servers[i].getErrorPages(), mimeTypes);
+        const VectorLocationConfig& locations = servers[i].getLocations();
+        for (size_t j = 0; j < locations.size(); ++j)
+            renderAll(locations[j].getErrorPages(), mimeTypes);
+    }
+}
+
+// The page for code under route's location or server error_page (location
+// first), else the built-in one; NULL for a status without either.
+const CachedContent* ErrorPageCache::find(const RouteResult& route, int code) const {
+    String path = route.getLocation() ? route.getLocation()->getErrorPage(code) : "";
+    if (path.empty() && route.getServer())
+        path = route.getServer()->getErrorPage(code);
+    PageMap::const_iterator it = pages.find(PageKey(path, code));
+    if (it == pages.end() && !path.empty())
+        it = pages.find(PageKey(String(), code));
+    return it != pages.end() ? &it->second : NULL;
+}
+
+size_t ErrorPageCache::size() const {
+    return pages.size();
+}
@@ -0,0 +1,38 @@
+#ifndef ERROR_PAGE_CACHE_HPP
+#define ERROR_PAGE_CACHE_HPP
+
+#include <map>
+#include "../config/MimeTypes.hpp"
+#include "../config/ServerConfig.hpp"
+#include "ContentCache.hpp"
+#include "RouteResult.hpp"
+
+// Every error response the configuration can produce, rendered once when the
+// configuration is loaded: the built-in page for each known 4xx/5xx status
+// and each error_page file of every server and location. Pages are keyed by
+// file path and status, so a file shared by many locations is held once. A
+// hit is queued like a content cache hit, as a single buffer.
+//
+// error_page files are read at load time only; edits need a restart.
+class ErrorPageCache {
+   public:
+    ErrorPageCache();
+    ErrorPageCache(const ErrorPageCache& other);
+    ErrorPageCache& operator=(const ErrorPageCache& other);
+    ~ErrorPageCache();
+
+    void                 build(const VectorServerConfig& servers, const MimeTypes& mimeTypes);
+    const CachedContent* find(const RouteResult& route, int code) const;
+    size_t               size() const;
+
+   private:
+    typedef std::pair<String, int>           PageKey; // error_page path ("" for built-in), status
+    typedef std::map<PageKey, CachedContent> PageMap;
+
+    void render(const String& path, int code, const MimeTypes& mimeTypes);
+    void renderAll(const MapIntString& errorPages, const MimeTypes& mimeTypes);
+
+    PageMap pages;
+};
+
+#endif
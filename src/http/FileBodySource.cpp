@@ -0,0 +1,43 @@
+#include "FileBodySource.hpp"
+
+FileBodySource::FileBodySource(int _fd, off_t _offset, size_t _length) : fd(_fd), offset(_offset), remaining(_length) {}
+
+// Each copy owns its own descriptor.
+FileBodySource::FileBodySource(const FileBodySource& other)
+    : IBodySource(), fd(other.fd == INVALID_FD ? INVALID_FD : dup(other.fd)), offset(other.offset), remaining(other.remaining) {}
+
+FileBodySource::~FileBodySource() {
+    if (fd != INVALID_FD)
+        close(fd);
+}
+
+// A file that ends before `remaining` bytes were sent returns -1: the
+// advertised Content-Length can no longer be honoured.
+ssize_t FileBodySource::writeTo(int sockFd, size_t maxBytes) {
+    size_t chunk = remaining < maxBytes ? remaining : maxBytes;
+    if (chunk == 0)
+        return 0;
+#ifdef __linux__
+    ssize_t sent = sendfile(sockFd, fd, &offset, chunk);
+#else
+    char    buf[BUFFER_SIZE];
+    ssize_t got  = pread(fd, buf, chunk < sizeof(buf) ? chunk : sizeof(buf), offset);
+    ssize_t sent = got <= 0 ? got : write(sockFd, buf, got);
+    if (sent > 0)
+        offset += sent;
+#endif
+    if (sent == 0)
+        return -1;
+    if (sent < 0)
+        return 0;
+    remaining -= sent;
+    return sent;
+}
+
+bool FileBodySource::isDone() const {
+    return remaining == 0;
+}
+
+IBodySource* FileBodySource::clone() const {
+    return new FileBodySource(*this);
+}
@@ -0,0 +1,29 @@
+#ifndef FILE_BODY_SOURCE_HPP
+#define FILE_BODY_SOURCE_HPP
+#ifdef __linux__
+#include <sys/sendfile.h>
+#endif
+#include "../utils/Utils.hpp"
+#include "IBodySource.hpp"
+
+// length bytes of fd starting at offset, sent with sendfile(). Owns fd.
+class FileBodySource : public IBodySource {
+   public:
+    FileBodySource(int fd, off_t offset, size_t length);
+    FileBodySource(const FileBodySource& other);
+    ~FileBodySource();
+
+    ssize_t      writeTo(int sockFd, size_t maxBytes);
+    bool         isDone() const;
+    IBodySource* clone() const;
+
+   private:
+    FileBodySource();
+    FileBodySource& operator=(const FileBodySource& other);
+
+    int    fd;
+    off_t  offset;
+    size_t remaining;
+};
+
+#endif
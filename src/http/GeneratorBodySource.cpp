@@ -0,0 +1,74 @@
+#include "GeneratorBodySource.hpp"
+
+GeneratorBodySource::GeneratorBodySource(bool _chunked) : chunked(_chunked), finished(false), pending(), offset(0) {}
+
+GeneratorBodySource::GeneratorBodySource(const GeneratorBodySource& other)
+    : IBodySource(), chunked(other.chunked), finished(other.finished), pending(other.pending), offset(other.offset) {}
+
+GeneratorBodySource& GeneratorBodySource::operator=(const GeneratorBodySource& other) {
+    if (this != &other) {
+        chunked  = other.chunked;
+        finished = other.finished;
+        pending  = other.pending;
+        offset   = other.offset;
+    }
+    return *this;
+}
+
+GeneratorBodySource::~GeneratorBodySource() {}
+
+// Refills `pending` with the next framed piece; false once exhausted.
+bool GeneratorBodySource::fill() {
+    pending.clear();
+    offset = 0;
+    while (pending.empty() && !finished) {
+        String piece;
+        finished = !produce(piece);
+        if (!chunked)
+            pending.swap(piece);
+        else if (!piece.empty()) {
+            std::ostringstream size;
+            size << std::hex << piece.size();
+            pending.reserve(piece.size() + 16);
+            pending.append(size.str()).append("\r\n").append(piece).append("\r\n");
+        }
+        if (finished && chunked)
+            pending.append("0\r\n\r\n");
+    }
+    return !pending.empty();
+}
+
+ssize_t GeneratorBodySource::writeTo(int sockFd, size_t maxBytes) {
+    size_t total = 0;
+    while (total < maxBytes) {
+        if (offset >= pending.size() && !fill())
+            break;
+        size_t len = pending.size() - offset;
+        if (len > maxBytes - total)
+            len = maxBytes - total;
+        ssize_t sent = write(sockFd, pending.data() + offset, len);
+        if (sent <= 0)
+            break;
+        offset += sent;
+        total += sent;
+    }
+    return total;
+}
+
+bool GeneratorBodySource::isDone() const {
+    return finished && offset >= pending.size();
+}
+
+// The next raw piece, bypassing the framing, for a source that transforms
+// this one's output (see GzipBodySource).
+bool GeneratorBodySource::pull(String& out) {
+    return produce(out);
+}
+
+void GeneratorBodySource::drain(String& out) {
+    if (offset < pending.size())
+        out.append(pending, offset, String::npos);
+    while (fill())
+        out.append(pending);
+    offset = pending.size();
+}
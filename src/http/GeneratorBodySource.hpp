@@ -0,0 +1,35 @@
+#ifndef GENERATOR_BODY_SOURCE_HPP
+#define GENERATOR_BODY_SOURCE_HPP
+#include "../utils/Utils.hpp"
+#include "IBodySource.hpp"
+
+// Base for bodies produced piece by piece. Subclasses implement produce(),
+// which appends the next piece and returns false once nothing is left.
+// With `chunked` set each piece is framed for Transfer-Encoding: chunked;
+// otherwise drain() renders the whole body for a Content-Length response.
+class GeneratorBodySource : public IBodySource {
+   public:
+    explicit GeneratorBodySource(bool chunked);
+    GeneratorBodySource(const GeneratorBodySource& other);
+    GeneratorBodySource& operator=(const GeneratorBodySource& other);
+    virtual ~GeneratorBodySource();
+
+    ssize_t writeTo(int sockFd, size_t maxBytes);
+    bool    isDone() const;
+    void    drain(String& out);
+    bool    pull(String& out);
+
+   protected:
+    virtual bool produce(String& out) = 0;
+
+   private:
+    GeneratorBodySource();
+    bool fill();
+
+    bool   chunked;
+    bool   finished;
+    String pending;
+    size_t offset;
+};
+
+#endif
@@ -0,0 +1,46 @@
+#include "GzipBodySource.hpp"
+
+GzipBodySource::GzipBodySource(String& body, int level, bool chunked)
+    : GeneratorBodySource(chunked), encoder(level), upstream(NULL), input(), inputOffset(0) {
+    input.swap(body);
+}
+
+GzipBodySource::GzipBodySource(GeneratorBodySource* _upstream, int level, bool chunked)
+    : GeneratorBodySource(chunked), encoder(level), upstream(_upstream), input(), inputOffset(0) {}
+
+GzipBodySource::GzipBodySource(const GzipBodySource& other)
+    : GeneratorBodySource(other),
+      encoder(other.encoder),
+      upstream(other.upstream ? static_cast<GeneratorBodySource*>(other.upstream->clone()) : NULL),
+      input(other.input),
+      inputOffset(other.inputOffset) {}
+
+GzipBodySource::~GzipBodySource() {
+    delete upstream;
+}
+
+IBodySource* GzipBodySource::clone() const {
+    return new GzipBodySource(*this);
+}
+
+// Compresses about GZIP_CHUNK_SIZE bytes of input per piece; small
+// upstream pieces are gathered first so blocks and chunks stay large.
+bool GzipBodySource::produce(String& out) {
+    bool more = true;
+    if (upstream) {
+        String piece;
+        while (more && piece.size() < GZIP_CHUNK_SIZE)
+            more = upstream->pull(piece);
+        encoder.compress(piece.data(), piece.size(), out);
+    } else {
+        size_t len = input.size() - inputOffset;
+        if (len > GZIP_CHUNK_SIZE)
+            len = GZIP_CHUNK_SIZE;
+        encoder.compress(input.data() + inputOffset, len, out);
+        inputOffset += len;
+        more = inputOffset < input.size();
+    }
+    if (!more)
+        encoder.finish(out);
+    return more;
+}
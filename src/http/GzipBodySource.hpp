@@ -0,0 +1,32 @@
+#ifndef GZIP_BODY_SOURCE_HPP
+#define GZIP_BODY_SOURCE_HPP
+#include "../utils/GzipEncoder.hpp"
+#include "GeneratorBodySource.hpp"
+
+// gzip-encodes another body as the socket drains: either a rendered body
+// taken over by swap, or a GeneratorBodySource it owns and pulls from.
+// Each piece compresses about GZIP_CHUNK_SIZE bytes of input, so a large
+// body never holds the event loop for long.
+class GzipBodySource : public GeneratorBodySource {
+   public:
+    GzipBodySource(String& body, int level, bool chunked);
+    GzipBodySource(GeneratorBodySource* upstream, int level, bool chunked);
+    GzipBodySource(const GzipBodySource& other);
+    ~GzipBodySource();
+
+    IBodySource* clone() const;
+
+   protected:
+    bool produce(String& out);
+
+   private:
+    GzipBodySource();
+    GzipBodySource& operator=(const GzipBodySource& other);
+
+    GzipEncoder          encoder;
+    GeneratorBodySource* upstream; // owned, NULL when compressing `input`
+    String               input;
+    size_t               inputOffset;
+};
+
+#endif
@@ -6,14 +6,23 @@ HttpRequest::HttpRequest()
       httpVersion(""),
       queryString(""),
       fragment(""),
-      headers(),
+      head(),
+      fields(),
+      lines(),
+      scanPos(0),
+      lineStart(0),
       body(""),
       contentType(""),
       contentLength(0),
       host(""),
       port(80),
       cookies(),
-      errorCode(0) {}
+      cookiesParsed(false),
+      queryParams(),
+      queryParsed(false),
+      errorCode(0) {
+    std::fill(known, known + FIELD_UNKNOWN, -1);
+}
 
 HttpRequest::HttpRequest(const HttpRequest& other)
     : method(other.method),
@@ -21,14 +30,23 @@ HttpRequest::HttpRequest(const HttpRequest& other)
       httpVersion(other.httpVersion),
       queryString(other.queryString),
       fragment(other.fragment),
-      headers(other.headers),
+      head(other.head),
+      fields(other.fields),
+      lines(other.lines),
+      scanPos(other.scanPos),
+      lineStart(other.lineStart),
       body(other.body),
       contentType(other.contentType),
       contentLength(other.contentLength),
       host(other.host),
       port(other.port),
       cookies(other.cookies),
-      errorCode(other.errorCode) {}
+      cookiesParsed(other.cookiesParsed),
+      queryParams(other.queryParams),
+      queryParsed(other.queryParsed),
+      errorCode(other.errorCode) {
+    std::copy(other.known, other.known + FIELD_UNKNOWN, known);
+}
 
 HttpRequest& HttpRequest::operator=(const HttpRequest& other) {
     if (this != &other) {
@@ -37,13 +55,21 @@ HttpRequest& HttpRequest::operator=(const HttpRequest& other) {
         httpVersion   = other.httpVersion;
         queryString   = other.queryString;
         fragment      = other.fragment;
-        headers       = other.headers;
+        head          = other.head;
+        fields        = other.fields;
+        std::copy(other.known, other.known + FIELD_UNKNOWN, known);
+        lines         = other.lines;
+        scanPos       = other.scanPos;
+        lineStart     = other.lineStart;
         body          = other.body;
         contentType   = other.contentType;
         contentLength = other.contentLength;
         host          = other.host;
         port          = other.port;
         cookies       = other.cookies;
+        cookiesParsed = other.cookiesParsed;
+        queryParams   = other.queryParams;
+        queryParsed   = other.queryParsed;
         errorCode     = other.errorCode;
     }
     return *this;
@@ -57,31 +83,43 @@ void HttpRequest::clear() {
     httpVersion = "";
     queryString = "";
     fragment    = "";
-    headers.clear();
+    head.clear();
+    fields.clear();
+    std::fill(known, known + FIELD_UNKNOWN, -1);
+    lines.clear();
+    scanPos       = 0;
+    lineStart     = 0;
     body          = "";
     contentType   = "";
     contentLength = 0;
     host          = "";
     port          = 80;
     cookies.clear();
-    errorCode = 0;
+    cookiesParsed = false;
+    queryParams.clear();
+    queryParsed   = false;
+    errorCode     = 0;
+}
+
+void HttpRequest::releaseBuffers(size_t maxCapacity) {
+    clear();
+    releaseIfLarger(head, maxCapacity);
+    releaseIfLarger(body, maxCapacity);
 }
 
 bool HttpRequest::parse(const String& raw) {
-    errorCode        = 0;
-    size_t headerEnd = raw.find(DOUBLE_CRLF);
-    if (headerEnd == String::npos) {
+    errorCode = 0;
+    size_t headLength;
+    if (findSequence(raw, DOUBLE_CRLF) == String::npos || !scanHead(raw.data(), raw.size(), headLength)) {
         errorCode = HTTP_BAD_REQUEST;
         return false;
     }
-    String headerSection = raw.substr(0, headerEnd);
-    String bodySection   = raw.substr(headerEnd + 4); // +4 to skip \r\n\r\n
-    if (!parseHeaders(headerSection)) {
+    if (!parseHead(raw.data(), headLength)) {
         if (errorCode == 0)
             errorCode = HTTP_BAD_REQUEST;
         return Logger::error("Failed to parse headers");
     }
-    if (!parseBody(bodySection)) {
+    if (!parseBody(raw.substr(headLength))) {
         if (errorCode == 0)
             errorCode = HTTP_BAD_REQUEST;
         return Logger::error("Failed to parse body");
@@ -124,94 +162,136 @@ bool HttpRequest::parseRequestLine(const String& requestLine) {
         fragment = "";
     if (!splitByChar(uri, uri, queryString, QUESTION))
         queryString = "";
-    else
-        queryString = urlDecode(queryString);
     uri = urlDecode(uri);
     return true;
 }
 
-bool HttpRequest::parseHeaders(const String& headerSection) {
-    size_t lineEnd    = headerSection.find(CRLF);
-    size_t lineEndLen = 2;
-    if (lineEnd == String::npos) {
-        lineEnd    = headerSection.find("\n");
-        lineEndLen = 1;
+// Resumable search for the blank line that ends the head. Each call only
+// looks at bytes received since the previous one, so a head trickled in one
+// byte at a time is still scanned once; complete lines are kept as spans for
+// parseHead(). Bare LF line ends are accepted like CRLF.
+bool HttpRequest::scanHead(const char* data, size_t size, size_t& headLength) {
+    const char* end = data + size;
+    while (scanPos < size) {
+        const char* newline = scanByte(data + scanPos, end, '\n');
+        if (newline == end) {
+            scanPos = size;
+            return false;
+        }
+        size_t at      = newline - data;
+        size_t lineEnd = (at > lineStart && data[at - 1] == '\r') ? at - 1 : at;
+        scanPos        = at + 1;
+        if (lineEnd == lineStart) {
+            headLength = scanPos;
+            return true;
+        }
+        lines.push_back(LineSpan(lineStart, lineEnd - lineStart));
+        lineStart = scanPos;
     }
+    return false;
+}
 
-    if (lineEnd == String::npos) {
-        lineEnd    = headerSection.size();
-        lineEndLen = 0;
-    }
+// Lower-case names of the fields with a HeaderId, in enum order.
+static const char* const FIELD_NAMES[FIELD_UNKNOWN] = {
+    "host",           "connection", "content-length", "content-type", "transfer-encoding", "cookie",
+    "accept-encoding", "if-none-match", "if-modified-since", "if-range", "range", "content-disposition"};
 
-    if (lineEnd == 0) {
-        errorCode = HTTP_BAD_REQUEST;
-        return Logger::error("Empty request line");
-    }
+static bool equalsIgnoreCase(const char* a, const char* b, size_t length) {
+    for (size_t i = 0; i < length; ++i)
+        if (std::tolower(static_cast<unsigned char>(a[i])) != std::tolower(static_cast<unsigned char>(b[i])))
+            return false;
+    return true;
+}
 
-    if (!parseRequestLine(headerSection.substr(0, lineEnd)))
-        return false;
+HeaderId HttpRequest::headerId(const char* name, size_t length) {
+    for (int id = 0; id < FIELD_UNKNOWN; ++id)
+        if (std::strlen(FIELD_NAMES[id]) == length && equalsIgnoreCase(name, FIELD_NAMES[id], length))
+            return static_cast<HeaderId>(id);
+    return FIELD_UNKNOWN;
+}
 
-    size_t pos = lineEnd + lineEndLen;
-    while (pos < headerSection.size()) {
-        lineEnd    = headerSection.find(CRLF, pos);
-        lineEndLen = 2;
-        if (lineEnd == String::npos) {
-            lineEnd    = headerSection.find("\n", pos);
-            lineEndLen = 1;
-        }
-        if (lineEnd == String::npos) {
-            lineEnd    = headerSection.size();
-            lineEndLen = 0;
-        }
+bool HttpRequest::isField(const HeaderField& field, const char* name, size_t length) const {
+    return field.nameLength == length && equalsIgnoreCase(head.data() + field.name, name, length);
+}
 
-        String line = headerSection.substr(pos, lineEnd - pos);
-        if (line.empty())
-            break;
+static bool isBlank(char c) {
+    return c == ' ' || c == '\t';
+}
 
-        String key, value;
-        if (!splitByChar(line, key, value, COLON)) {
+// "Name: value" recorded as spans into head; nothing is copied.
+bool HttpRequest::parseField(const LineSpan& line) {
+    size_t end   = line.first + line.second;
+    size_t colon = scanByte(head.data() + line.first, head.data() + end, COLON) - head.data();
+    if (colon == end) {
+        errorCode = HTTP_BAD_REQUEST;
+        return Logger::error("Failed to parse header line");
+    }
+    size_t nameStart  = line.first;
+    size_t nameEnd    = colon;
+    size_t valueStart = colon + 1;
+    size_t valueEnd   = end;
+    while (nameStart < nameEnd && isBlank(head[nameStart]))
+        ++nameStart;
+    while (nameEnd > nameStart && isBlank(head[nameEnd - 1]))
+        --nameEnd;
+    while (valueStart < valueEnd && isBlank(head[valueStart]))
+        ++valueStart;
+    while (valueEnd > valueStart && isBlank(head[valueEnd - 1]))
+        --valueEnd;
+    if (nameStart == nameEnd) {
+        errorCode = HTTP_BAD_REQUEST;
+        return Logger::error("Empty header name");
+    }
+    HeaderField field;
+    field.name        = nameStart;
+    field.nameLength  = nameEnd - nameStart;
+    field.value       = valueStart;
+    field.valueLength = valueEnd - valueStart;
+    field.id          = headerId(head.data() + field.name, field.nameLength);
+    field.next        = -1;
+    if (field.valueLength > 0 && field.id != FIELD_UNKNOWN) {
+        if (field.id == FIELD_CONTENT_LENGTH && hasHeader(FIELD_CONTENT_LENGTH)) {
             errorCode = HTTP_BAD_REQUEST;
-            return Logger::error("Failed to parse header line");
+            return Logger::error("Multiple Content-Length headers not allowed");
         }
+        int* link = &known[field.id];
+        while (*link >= 0)
+            link = &fields[*link].next;
+        *link = static_cast<int>(fields.size());
+    }
+    fields.push_back(field);
+    return true;
+}
 
-        String headerKey = toLowerWords(trimSpaces(key));
-        String headerVal = trimSpaces(value);
-
-        if (headerKey == "content-length") {
-            if (hasNonEmptyValue(headers, headerKey)) {
-                errorCode = HTTP_BAD_REQUEST;
-                return Logger::error("Multiple Content-Length headers not allowed");
-            }
-            headers[headerKey] = headerVal;
-        } else {
-            // RFC 7230: Multiple headers with same name should append with comma
-            if (!hasNonEmptyValue(headers, headerKey))
-                headers[headerKey] = headerVal;
-            else
-                headers[headerKey] += "," + headerVal;
-        }
-        pos = lineEnd + lineEndLen;
+// Parses the head found by scanHead(). The head is copied out of the receive
+// buffer once, since the buffer is compacted as soon as the head is consumed;
+// header values are only materialized by getHeader().
+bool HttpRequest::parseHead(const char* data, size_t headLength) {
+    head.assign(data, headLength);
+    if (lines.empty()) {
+        errorCode = HTTP_BAD_REQUEST;
+        return Logger::error("Empty request line");
     }
+    if (!parseRequestLine(head.substr(lines[0].first, lines[0].second)))
+        return false;
+    for (size_t i = 1; i < lines.size(); ++i)
+        if (!parseField(lines[i]))
+            return false;
 
     if (!validateHostHeader()) {
         errorCode = HTTP_BAD_REQUEST;
         return Logger::error("Missing or invalid Host header");
     }
 
-    String cookieHeader = getValue(headers, String(HEADER_COOKIE), String());
-    if (!cookieHeader.empty())
-        parseCookies(cookieHeader);
-
-    String ct = getValue(headers, String("content-type"), String());
-    if (!ct.empty())
-        contentType = ct;
+    if (hasHeader(FIELD_CONTENT_TYPE))
+        contentType = getHeader(FIELD_CONTENT_TYPE);
 
     if (!validateContentLength()) {
         return Logger::error("Invalid Content-Length header");
     }
 
     String portStr;
-    String hostHeader = getValue(headers, String(HEADER_HOST), String());
+    String hostHeader = getHeader(FIELD_HOST);
     if (!hostHeader.empty()) {
         if (!splitByChar(hostHeader, host, portStr, COLON)) {
             host = hostHeader;
@@ -227,7 +307,7 @@ bool HttpRequest::parseBody(const String& bodySection) {
     body = bodySection;
     bool methodExpectsBody = isMethodWithBody(method);
 
-    if (hasNonEmptyValue(headers, String("content-length"))) {
+    if (hasHeader(FIELD_CONTENT_LENGTH)) {
         if (body.size() != contentLength) {
             errorCode = HTTP_BAD_REQUEST;
             return Logger::error("Body length does not match Content-Length");
@@ -247,22 +327,15 @@ bool HttpRequest::parseBody(const String& bodySection) {
 }
 
 bool HttpRequest::validateHostHeader() {
-    if (httpVersion == HTTP_VERSION_1_1) {
-        MapString::const_iterator it = headers.find(HEADER_HOST);
-        if (it == headers.end() || it->second.empty()) {
-            return false;
-        }
-    }
-    return true;
+    return httpVersion != HTTP_VERSION_1_1 || hasHeader(FIELD_HOST);
 }
 
 bool HttpRequest::validateContentLength() {
-    MapString::const_iterator it = headers.find("content-length");
-    if (it == headers.end() || it->second.empty()) {
+    String clValue = getHeader(FIELD_CONTENT_LENGTH);
+    if (clValue.empty()) {
         contentLength = 0;
         return true;
     }
-    const String& clValue = it->second;
     for (size_t i = 0; i < clValue.length(); ++i) {
         if (!std::isdigit(static_cast<unsigned char>(clValue[i]))) {
             errorCode = HTTP_BAD_REQUEST;
@@ -277,9 +350,10 @@ bool HttpRequest::validateContentLength() {
     }
     return true;
 }
-void HttpRequest::parseCookies(const String& cookieHeader) {
+void HttpRequest::parseCookies() const {
+    cookiesParsed = true;
     VectorString cookiePairs;
-    splitByString(cookieHeader, cookiePairs, ";");
+    splitByString(getHeader(FIELD_COOKIE), cookiePairs, ";");
     for (size_t i = 0; i < cookiePairs.size(); ++i) {
         String key, value;
         if (splitByChar(trimSpaces(cookiePairs[i]), key, value, EQUALS))
@@ -287,16 +361,95 @@ void HttpRequest::parseCookies(const String& cookieHeader) {
     }
 }
 
+// The query string stays as received, for CGI's QUERY_STRING; parameters are
+// split and decoded the first time one is asked for. '+' stands for a space
+// as in form encoding; a parameter without '=' has an empty value.
+void HttpRequest::parseQuery() const {
+    queryParsed = true;
+    size_t pos  = 0;
+    while (pos < queryString.size()) {
+        size_t end = queryString.find(AMPERSAND, pos);
+        if (end == String::npos)
+            end = queryString.size();
+        String pair = queryString.substr(pos, end - pos);
+        pos         = end + 1;
+        if (pair.empty())
+            continue;
+        std::replace(pair.begin(), pair.end(), '+', ' ');
+        String key, value;
+        if (!splitByChar(pair, key, value, EQUALS))
+            key = pair;
+        key = urlDecode(key);
+        if (queryParams.find(key) == queryParams.end())
+            queryParams[key] = urlDecode(value);
+    }
+}
+
 const String& HttpRequest::getMethod() const { return method; }
 const String& HttpRequest::getUri() const { return uri; }
 const String& HttpRequest::getHttpVersion() const { return httpVersion; }
 
+// Value of the named field (any case), repeated fields joined with ",". Only
+// this copy is allocated; the fields themselves stay spans into head.
 String HttpRequest::getHeader(const String& key) const {
-    MapString::const_iterator it = headers.find(toLowerWords(key));
-    return it != headers.end() ? it->second : "";
+    HeaderId id = headerId(key.data(), key.size());
+    if (id != FIELD_UNKNOWN)
+        return getHeader(id);
+    String value;
+    for (size_t i = 0; i < fields.size(); ++i) {
+        const HeaderField& field = fields[i];
+        if (field.id != FIELD_UNKNOWN || field.valueLength == 0 || !isField(field, key.data(), key.size()))
+            continue;
+        if (!value.empty())
+            value += ",";
+        value.append(head, field.value, field.valueLength);
+    }
+    return value;
+}
+
+String HttpRequest::getHeader(HeaderId id) const {
+    String value;
+    for (int i = known[id]; i >= 0; i = fields[i].next) {
+        if (!value.empty())
+            value += ",";
+        value.append(head, fields[i].value, fields[i].valueLength);
+    }
+    return value;
 }
 
-const MapString& HttpRequest::getHeaders() const { return headers; }
+bool HttpRequest::hasHeader(HeaderId id) const { return known[id] >= 0; }
+
+// Whether a comma-separated field lists `token` (any case), checked in place.
+bool HttpRequest::hasHeaderToken(HeaderId id, const String& token) const {
+    for (int i = known[id]; i >= 0; i = fields[i].next) {
+        size_t pos = fields[i].value;
+        size_t end = pos + fields[i].valueLength;
+        while (pos < end) {
+            size_t comma = scanByte(head.data() + pos, head.data() + end, ',') - head.data();
+            size_t first = pos;
+            size_t last  = comma;
+            while (first < last && isBlank(head[first]))
+                ++first;
+            while (last > first && isBlank(head[last - 1]))
+                --last;
+            if (last - first == token.size() && equalsIgnoreCase(head.data() + first, token.data(), token.size()))
+                return true;
+            pos = comma + 1;
+        }
+    }
+    return false;
+}
+
+// Every field keyed by its lower-case name, for the CGI environment.
+MapString HttpRequest::getHeaders() const {
+    MapString all;
+    for (size_t i = 0; i < fields.size(); ++i) {
+        String name = toLowerWords(head.substr(fields[i].name, fields[i].nameLength));
+        if (!all.count(name))
+            all[name] = getHeader(name);
+    }
+    return all;
+}
 const String& HttpRequest::getBody() const { return body; }
 size_t HttpRequest::getContentLength() const { return contentLength; }
 const String& HttpRequest::getContentType() const { return contentType; }
@@ -307,10 +460,29 @@ bool HttpRequest::isComplete() const { return !method.empty() && !uri.empty() &&
 bool HttpRequest::hasBody() const { return !body.empty(); }
 
 String HttpRequest::getCookie(const String& key) const {
+    if (!cookiesParsed)
+        parseCookies();
     MapString::const_iterator it = cookies.find(key);
     return it != cookies.end() ? it->second : "";
 }
 
-const MapString& HttpRequest::getCookies() const { return cookies; }
+const MapString& HttpRequest::getCookies() const {
+    if (!cookiesParsed)
+        parseCookies();
+    return cookies;
+}
 int HttpRequest::getErrorCode() const { return errorCode; }
-const String& HttpRequest::getQueryString() const { return queryString; }
\ No newline at end of file
+const String& HttpRequest::getQueryString() const { return queryString; }
+
+String HttpRequest::getQueryParam(const String& key) const {
+    if (!queryParsed)
+        parseQuery();
+    MapString::const_iterator it = queryParams.find(key);
+    return it != queryParams.end() ? it->second : "";
+}
+
+const MapString& HttpRequest::getQueryParams() const {
+    if (!queryParsed)
+        parseQuery();
+    return queryParams;
+}
\ No newline at end of file
@@ -1,28 +1,56 @@
 #ifndef HTTPREQUEST_HPP
 #define HTTPREQUEST_HPP
 
+#include <algorithm>
+#include <cstring>
 #include <iostream>
 #include <map>
 #include <sstream>
 #include "../utils/Utils.hpp"
 
+// A header field as offsets into the request's head; the name keeps the
+// client's case and both spans are trimmed of surrounding whitespace.
+// Well-known names are resolved to an id once, at parse time.
+struct HeaderField {
+    size_t   name;
+    size_t   nameLength;
+    size_t   value;
+    size_t   valueLength;
+    HeaderId id;
+    int      next; // next non-empty field with the same id, or -1
+};
+
+typedef std::pair<size_t, size_t> LineSpan; // offset and length, line end excluded
+
 class HttpRequest {
    private:
-    String    method;        // GET, POST, DELETE
-    String    uri;           // /path/to/resource
-    String    httpVersion;   // HTTP/1.1
-    String    queryString;   // ?key=value
-    String    fragment;      // #section
-    MapString headers;       // Header key-value pairs
-    String    body;          // Request body
-    String    contentType;   // e.g., text/html Mime type
-    size_t    contentLength; // e.g., 348
-    String    host;          // Host from Host header
-    int       port;          // Port from Host header
-    MapString cookies;       // Cookies from Cookie header
-    int       errorCode;     // HTTP error code (0 if no error)
+    String                   method;        // GET, POST, DELETE
+    String                   uri;           // /path/to/resource
+    String                   httpVersion;   // HTTP/1.1
+    String                   queryString;   // ?key=value, as received
+    String                   fragment;      // #section
+    String                   head;          // request line and header lines, copied once
+    std::vector<HeaderField> fields;        // spans into head, in arrival order
+    int                      known[FIELD_UNKNOWN]; // first non-empty field per id, or -1
+    std::vector<LineSpan>    lines;         // complete head lines found so far
+    size_t                   scanPos;       // received bytes already scanned
+    size_t                   lineStart;     // start of the line being scanned
+    String                   body;          // Request body
+    String                   contentType;   // e.g., text/html Mime type
+    size_t                   contentLength; // e.g., 348
+    String                   host;          // Host from Host header
+    int                      port;          // Port from Host header
+    mutable MapString        cookies;       // Cookies from Cookie header
+    mutable bool             cookiesParsed; // cookies are parsed on first access
+    mutable MapString        queryParams;   // decoded query parameters
+    mutable bool             queryParsed;   // the query is decoded on first access
+    int                      errorCode;     // HTTP error code (0 if no error)
 
     bool parseRequestLine(const String& requestLine);
+    bool parseField(const LineSpan& line);
+    bool isField(const HeaderField& field, const char* name, size_t length) const;
+    void parseCookies() const;
+    void parseQuery() const;
 
    public:
     HttpRequest();
@@ -30,18 +58,24 @@ class HttpRequest {
     HttpRequest& operator=(const HttpRequest& other);
     ~HttpRequest();
     void clear();
+    void releaseBuffers(size_t maxCapacity);
     // Parsing
     bool parse(const String& raw);
-    bool parseHeaders(const String& headerSection);
+    bool scanHead(const char* data, size_t size, size_t& headLength);
+    bool parseHead(const char* data, size_t headLength);
     bool parseBody(const String& bodySection);
-    void parseCookies(const String& cookieHeader);
+
+    static HeaderId headerId(const char* name, size_t length);
 
     // Getters
     const String&    getMethod() const;
     const String&    getUri() const;
     const String&    getHttpVersion() const;
     String           getHeader(const String& key) const;
-    const MapString& getHeaders() const;
+    String           getHeader(HeaderId id) const;
+    bool             hasHeader(HeaderId id) const;
+    bool             hasHeaderToken(HeaderId id, const String& token) const;
+    MapString        getHeaders() const;
     const String&    getBody() const;
     size_t           getContentLength() const;
     const String&    getContentType() const;
@@ -51,6 +85,8 @@ class HttpRequest {
     const MapString& getCookies() const;
     int              getErrorCode() const;
     const String&    getQueryString() const;
+    String           getQueryParam(const String& key) const;
+    const MapString& getQueryParams() const;
 
     // Setters
     void setPort(int serverPort);
@@ -1,13 +1,16 @@
 #include "HttpResponse.hpp"
 
-HttpResponse::HttpResponse() : statusCode(), statusMessage(), httpVersion(HTTP_VERSION_1_1), headers(), setCookies(), body() {}
+HttpResponse::HttpResponse()
+    : statusCode(), statusMessage(), httpVersion(HTTP_VERSION_1_1), headers(), setCookies(), body(), bodySource(NULL) {}
+
 HttpResponse::HttpResponse(const HttpResponse& other)
     : statusCode(other.statusCode),
       statusMessage(other.statusMessage),
       httpVersion(other.httpVersion),
       headers(other.headers),
       setCookies(other.setCookies),
-      body(other.body) {}
+      body(other.body),
+      bodySource(other.bodySource ? other.bodySource->clone() : NULL) {}
 
 HttpResponse& HttpResponse::operator=(const HttpResponse& other) {
     if (this != &other) {
@@ -17,10 +20,13 @@ HttpResponse& HttpResponse::operator=(const HttpResponse& other) {
         headers       = other.headers;
         setCookies    = other.setCookies;
         body          = other.body;
+        setBodySource(other.bodySource ? other.bodySource->clone() : NULL);
     }
     return *this;
 }
-HttpResponse::~HttpResponse() {}
+HttpResponse::~HttpResponse() {
+    delete bodySource;
+}
 
 void HttpResponse::setStatus(int code, const String& msg) {
     statusCode    = code;
@@ -30,6 +36,26 @@ void HttpResponse::addHeader(const String& key, const String& value) {
     headers[key] = value;
 }
 
+// Header names are matched case-insensitively: CGI scripts pick their own
+// spelling.
+String HttpResponse::getHeader(const String& name) const {
+    String wanted = toLowerWords(name);
+    for (MapString::const_iterator it = headers.begin(); it != headers.end(); ++it)
+        if (toLowerWords(it->first) == wanted)
+            return it->second;
+    return "";
+}
+
+void HttpResponse::removeHeader(const String& name) {
+    String wanted = toLowerWords(name);
+    for (MapString::iterator it = headers.begin(); it != headers.end();) {
+        if (toLowerWords(it->first) == wanted)
+            headers.erase(it++);
+        else
+            ++it;
+    }
+}
+
 void HttpResponse::addSetCookie(const String& cookie) {
     setCookies.push_back(cookie);
 }
@@ -39,6 +65,38 @@ void HttpResponse::setResponseHeaders(const String& contentType, size_t contentL
     addHeader(HEADER_CONTENT_LENGTH, typeToString<size_t>(contentLength));
 }
 
+// Strong validator built from stat() data alone, so it costs no read of the
+// file: "<inode>-<size>-<mtime>" in hex.
+String HttpResponse::entityTag(off_t size, time_t mtime, ino_t inode) {
+    std::ostringstream tag;
+    tag << '"' << std::hex << static_cast<unsigned long>(inode) << '-' << static_cast<unsigned long>(size) << '-'
+        << static_cast<unsigned long>(mtime) << '"';
+    return tag.str();
+}
+
+void HttpResponse::setValidators(off_t size, time_t mtime, ino_t inode) {
+    addHeader(HEADER_ETAG, entityTag(size, mtime, inode));
+    addHeader(HEADER_LAST_MODIFIED, formatDateTime(mtime));
+}
+
+// expires/cache_control: `expires` is a lifetime in seconds, EXPIRES_EPOCH
+// or EXPIRES_OFF; a cache_control value replaces the Cache-Control header
+// derived from it.
+void HttpResponse::setCacheHeaders(time_t expires, const String& cacheControl) {
+    String control;
+    if (expires == EXPIRES_EPOCH) {
+        addHeader(HEADER_EXPIRES, formatDateTime(1));
+        control = "no-cache";
+    } else if (expires >= 0) {
+        addHeader(HEADER_EXPIRES, formatDateTime(getCurrentTime() + expires));
+        control = "max-age=" + typeToString<time_t>(expires);
+    }
+    if (!cacheControl.empty())
+        control = cacheControl;
+    if (!control.empty())
+        addHeader(HEADER_CACHE_CONTROL, control);
+}
+
 int HttpResponse::getStatusCode() const {
     return statusCode;
 }
@@ -59,19 +117,103 @@ const String& HttpResponse::getBody() const {
     return body;
 }
 
-String HttpResponse::toString() const {
-    String hdr;
-    hdr += httpVersion + " " + typeToString<int>(statusCode) + " " + statusMessage + "\r\n";
-    hdr += String(HEADER_DATE) + ": " + formatDateTime() + "\r\n";
-    hdr += String(HEADER_SERVER) + ": Webserv/1.0\r\n";
+// Takes ownership of source; toString() then emits only the head and the
+// caller streams the body with releaseBodySource().
+void HttpResponse::setBodySource(IBodySource* source) {
+    if (source != bodySource)
+        delete bodySource;
+    bodySource = source;
+}
+
+void HttpResponse::setBodyFile(int fd, off_t offset, size_t length) {
+    setBodySource(new FileBodySource(fd, offset, length));
+}
+
+bool HttpResponse::hasBodySource() const {
+    return bodySource != NULL;
+}
+
+IBodySource* HttpResponse::releaseBodySource() {
+    IBodySource* source = bodySource;
+    bodySource          = NULL;
+    return source;
+}
+
+// "HTTP/1.1 <code> <reason>\r\n" for every code with a standard reason
+// phrase, built once; clients send it straight from this table.
+static VectorString buildStatusLines() {
+    VectorString table(600);
+    for (int code = 100; code < 600; ++code) {
+        String msg = getHttpStatusMessage(code);
+        if (msg != "Unknown Error")
+            table[code] = String(HTTP_VERSION_1_1) + " " + typeToString<int>(code) + " " + msg + "\r\n";
+    }
+    return table;
+}
+
+static const VectorString& statusLineTable() {
+    static const VectorString table = buildStatusLines();
+    return table;
+}
+
+// Prebuilt "HTTP/1.1 NNN Reason\r\n" for a known code, empty otherwise.
+const String& HttpResponse::statusLine(int code) {
+    static const String none;
+    if (code < 100 || code >= 600)
+        return none;
+    return statusLineTable()[code];
+}
+
+// The prebuilt line for this response, or NULL when it uses another
+// version or a non-standard reason phrase.
+const String* HttpResponse::getStatusLine() const {
+    if (httpVersion != HTTP_VERSION_1_1 || statusCode < 100 || statusCode >= 600)
+        return NULL;
+    const String& line   = statusLineTable()[statusCode];
+    size_t        prefix = sizeof(HTTP_VERSION_1_1) + 4; // "HTTP/1.1 NNN "
+    if (line.empty() || line.size() - prefix - 2 != statusMessage.size() || line.compare(prefix, statusMessage.size(), statusMessage) != 0)
+        return NULL;
+    return &line;
+}
+
+// Appends the head (optionally without its status line) to out, which the
+// caller keeps across responses so its capacity is reused.
+void HttpResponse::appendHead(String& out, const HttpDate& date, bool withStatusLine) const {
+    if (withStatusLine) {
+        const String* line = getStatusLine();
+        if (line)
+            out.append(*line);
+        else
+            out.append(httpVersion).append(" ").append(typeToString<int>(statusCode)).append(" ").append(statusMessage).append("\r\n");
+    }
+    out.append(date.getPrologue());
+    appendHeaders(out);
+    out.append("\r\n");
+}
+
+// Header lines only, without the Date/Server prologue or the blank line.
+void HttpResponse::appendHeaders(String& out) const {
     for (MapString::const_iterator it = headers.begin(); it != headers.end(); ++it)
-        hdr += it->first + ": " + it->second + "\r\n";
+        out.append(it->first).append(": ").append(it->second).append("\r\n");
     for (size_t i = 0; i < setCookies.size(); ++i)
-        hdr += String(HEADER_SET_COOKIE) + ": " + setCookies[i] + "\r\n";
-    hdr += "\r\n";
+        out.append(HEADER_SET_COOKIE ": ").append(setCookies[i]).append("\r\n");
+}
+
+// Hands the rendered body to the caller without copying it.
+void HttpResponse::takeBody(String& out) {
+    out.swap(body);
+    body.clear();
+}
+
+String HttpResponse::toString() const {
+    HttpDate date;
+    date.refresh(getCurrentTime());
+    return toString(date);
+}
+
+String HttpResponse::toString(const HttpDate& date) const {
     String result;
-    result.reserve(hdr.size() + body.size());
-    result.append(hdr);
+    appendHead(result, date, true);
     result.append(body);
     return result;
 }
@@ -3,7 +3,11 @@
 
 #include <map>
 #include <string>
+#include "../utils/HttpDate.hpp"
 #include "../utils/Utils.hpp"
+#include "FileBodySource.hpp"
+#include "IBodySource.hpp"
+#include "MemoryBodySource.hpp"
 
 class HttpResponse {
    public:
@@ -14,14 +18,30 @@ class HttpResponse {
 
     void   setStatus(int code, const String& msg);
     void   addHeader(const String&, const String&);
+    String getHeader(const String& name) const;
+    void   removeHeader(const String& name);
     void   addSetCookie(const String& cookie);
     void   setResponseHeaders(const String& contentType, size_t contentLength);
+    void   setValidators(off_t size, time_t mtime, ino_t inode);
+    void   setCacheHeaders(time_t expires, const String& cacheControl);
     void   setBody(const String&);
     void   setHttpVersion(const String& version);
     const String& getBody() const;
+    void   setBodyFile(int fd, off_t offset, size_t length);
+    void   setBodySource(IBodySource* source);
+    void   takeBody(String& out);
+    bool   hasBodySource() const;
+    IBodySource* releaseBodySource();
     String toString() const;
+    String toString(const HttpDate& date) const;
+    void   appendHead(String& out, const HttpDate& date, bool withStatusLine) const;
+    void   appendHeaders(String& out) const;
+    const String* getStatusLine() const;
     int    getStatusCode() const;
 
+    static const String& statusLine(int code);
+    static String        entityTag(off_t size, time_t mtime, ino_t inode);
+
     const String& getStatusMessage() const;
 
    private:
@@ -31,6 +51,7 @@ class HttpResponse {
     MapString    headers;
     VectorString setCookies;
     String       body;
+    IBodySource* bodySource; // owned; streamed after the head instead of `body`
 };
 
 #endif
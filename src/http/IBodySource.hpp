@@ -0,0 +1,18 @@
+#ifndef I_BODY_SOURCE_HPP
+#define I_BODY_SOURCE_HPP
+#include <sys/types.h>
+#include <cstddef>
+
+// A response body that is pulled as the socket drains instead of being
+// materialized up front. writeTo() pushes at most maxBytes to sockFd and
+// returns the bytes written, 0 when the socket would block, or -1 when the
+// body cannot be completed and the connection must be dropped.
+class IBodySource {
+   public:
+    virtual ~IBodySource() {}
+    virtual ssize_t      writeTo(int sockFd, size_t maxBytes) = 0;
+    virtual bool         isDone() const                       = 0;
+    virtual IBodySource* clone() const                        = 0;
+};
+
+#endif
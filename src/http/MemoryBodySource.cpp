@@ -0,0 +1,39 @@
+#include "MemoryBodySource.hpp"
+
+MemoryBodySource::MemoryBodySource() : data(), offset(0) {}
+
+// Steals the caller's buffer so large bodies are never copied.
+MemoryBodySource::MemoryBodySource(String& _data) : data(), offset(0) {
+    data.swap(_data);
+}
+
+MemoryBodySource::MemoryBodySource(const MemoryBodySource& other) : IBodySource(), data(other.data), offset(other.offset) {}
+
+MemoryBodySource& MemoryBodySource::operator=(const MemoryBodySource& other) {
+    if (this != &other) {
+        data   = other.data;
+        offset = other.offset;
+    }
+    return *this;
+}
+
+MemoryBodySource::~MemoryBodySource() {}
+
+ssize_t MemoryBodySource::writeTo(int sockFd, size_t maxBytes) {
+    size_t len = data.size() - offset;
+    if (len > maxBytes)
+        len = maxBytes;
+    ssize_t sent = write(sockFd, data.data() + offset, len);
+    if (sent <= 0)
+        return 0;
+    offset += sent;
+    return sent;
+}
+
+bool MemoryBodySource::isDone() const {
+    return offset >= data.size();
+}
+
+IBodySource* MemoryBodySource::clone() const {
+    return new MemoryBodySource(*this);
+}
@@ -0,0 +1,23 @@
+#ifndef MEMORY_BODY_SOURCE_HPP
+#define MEMORY_BODY_SOURCE_HPP
+#include "../utils/Utils.hpp"
+#include "IBodySource.hpp"
+
+class MemoryBodySource : public IBodySource {
+   public:
+    MemoryBodySource();
+    explicit MemoryBodySource(String& data);
+    MemoryBodySource(const MemoryBodySource& other);
+    MemoryBodySource& operator=(const MemoryBodySource& other);
+    ~MemoryBodySource();
+
+    ssize_t      writeTo(int sockFd, size_t maxBytes);
+    bool         isDone() const;
+    IBodySource* clone() const;
+
+   private:
+    String data;
+    size_t offset;
+};
+
+#endif
@@ -0,0 +1,94 @@
+#include "MultipartRangeSource.hpp"
+
+MultipartRangeSource::MultipartRangeSource(int _fd, const String& _boundary, const String& _contentType, off_t _fileSize)
+    : fd(_fd), boundary(_boundary), contentType(_contentType), fileSize(_fileSize), parts(), current(0), headOffset(0) {}
+
+// Each copy owns its own descriptor.
+MultipartRangeSource::MultipartRangeSource(const MultipartRangeSource& other)
+    : IBodySource(),
+      fd(other.fd == INVALID_FD ? INVALID_FD : dup(other.fd)),
+      boundary(other.boundary),
+      contentType(other.contentType),
+      fileSize(other.fileSize),
+      parts(other.parts),
+      current(other.current),
+      headOffset(other.headOffset) {}
+
+MultipartRangeSource::~MultipartRangeSource() {
+    if (fd != INVALID_FD)
+        close(fd);
+}
+
+void MultipartRangeSource::addRange(off_t first, off_t last) {
+    Part part;
+    part.head = String(parts.empty() ? "" : CRLF) + "--" + boundary + CRLF + HEADER_CONTENT_TYPE + ": " + contentType + CRLF + HEADER_CONTENT_RANGE + ": bytes " + typeToString<off_t>(first) + "-" + typeToString<off_t>(last) + "/" +
+                typeToString<off_t>(fileSize) + CRLF + CRLF;
+    part.offset = first;
+    part.length = static_cast<size_t>(last - first + 1);
+    parts.push_back(part);
+}
+
+// Appends the closing boundary; call once after the last addRange().
+void MultipartRangeSource::finish() {
+    Part part;
+    part.head   = String(CRLF) + "--" + boundary + "--" + CRLF;
+    part.offset = 0;
+    part.length = 0;
+    parts.push_back(part);
+}
+
+// Exact body size, for Content-Length.
+size_t MultipartRangeSource::getLength() const {
+    size_t total = 0;
+    for (size_t i = 0; i < parts.size(); ++i)
+        total += parts[i].head.size() + parts[i].length;
+    return total;
+}
+
+// Walks the parts until maxBytes are sent or the socket would block. As with
+// FileBodySource, a file that ends early returns -1.
+ssize_t MultipartRangeSource::writeTo(int sockFd, size_t maxBytes) {
+    size_t total = 0;
+    while (total < maxBytes && current < parts.size()) {
+        Part&   part = parts[current];
+        size_t  room = maxBytes - total;
+        ssize_t sent;
+        if (headOffset < part.head.size()) {
+            size_t len = part.head.size() - headOffset;
+            sent       = write(sockFd, part.head.data() + headOffset, len < room ? len : room);
+            if (sent > 0)
+                headOffset += sent;
+        } else {
+            size_t chunk = part.length < room ? part.length : room;
+#ifdef __linux__
+            sent = sendfile(sockFd, fd, &part.offset, chunk);
+#else
+            char    buf[BUFFER_SIZE];
+            ssize_t got = pread(fd, buf, chunk < sizeof(buf) ? chunk : sizeof(buf), part.offset);
+            sent        = got <= 0 ? got : write(sockFd, buf, got);
+            if (sent > 0)
+                part.offset += sent;
+#endif
+            if (sent == 0)
+                return -1;
+            if (sent > 0)
+                part.length -= sent;
+        }
+        if (sent <= 0)
+            break;
+        total += sent;
+        if (headOffset >= part.head.size() && part.length == 0) {
+            ++current;
+            headOffset = 0;
+        }
+    }
+    return static_cast<ssize_t>(total);
+}
+
+bool MultipartRangeSource::isDone() const {
+    return current >= parts.size();
+}
+
+IBodySource* MultipartRangeSource::clone() const {
+    return new MultipartRangeSource(*this);
+}
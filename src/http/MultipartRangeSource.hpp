@@ -0,0 +1,45 @@
+#ifndef MULTIPART_RANGE_SOURCE_HPP
+#define MULTIPART_RANGE_SOURCE_HPP
+#ifdef __linux__
+#include <sys/sendfile.h>
+#endif
+#include <vector>
+#include "../utils/Utils.hpp"
+#include "IBodySource.hpp"
+
+// multipart/byteranges body: each part is a small in-memory header followed
+// by a range of fd sent with sendfile(), so no range is copied through user
+// space. The closing boundary is a last part with no file bytes. Owns fd.
+class MultipartRangeSource : public IBodySource {
+   public:
+    MultipartRangeSource(int fd, const String& boundary, const String& contentType, off_t fileSize);
+    MultipartRangeSource(const MultipartRangeSource& other);
+    ~MultipartRangeSource();
+
+    void         addRange(off_t first, off_t last);
+    void         finish();
+    size_t       getLength() const;
+    ssize_t      writeTo(int sockFd, size_t maxBytes);
+    bool         isDone() const;
+    IBodySource* clone() const;
+
+   private:
+    struct Part {
+        String head;
+        off_t  offset;
+        size_t length;
+    };
+
+    MultipartRangeSource();
+    MultipartRangeSource& operator=(const MultipartRangeSource& other);
+
+    int               fd;
+    String            boundary;
+    String            contentType;
+    off_t             fileSize;
+    std::vector<Part> parts;
+    size_t            current;
+    size_t            headOffset;
+};
+
+#endif
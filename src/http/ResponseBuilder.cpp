@@ -1,16 +1,21 @@
 #include "ResponseBuilder.hpp"
 
-ResponseBuilder::ResponseBuilder() : mimeTypes() {}
-ResponseBuilder::ResponseBuilder(const MimeTypes& _mimeTypes) : mimeTypes(_mimeTypes) {}
-ResponseBuilder::ResponseBuilder(const ResponseBuilder& other) : mimeTypes(other.mimeTypes) {}
+ResponseBuilder::ResponseBuilder() : mimeTypes(), fileCache(NULL) {}
+ResponseBuilder::ResponseBuilder(const MimeTypes& _mimeTypes) : mimeTypes(_mimeTypes), fileCache(NULL) {}
+ResponseBuilder::ResponseBuilder(const ResponseBuilder& other) : mimeTypes(other.mimeTypes), fileCache(other.fileCache) {}
 ResponseBuilder& ResponseBuilder::operator=(const ResponseBuilder& other) {
     if (this != &other) {
         mimeTypes = other.mimeTypes;
+        fileCache = other.fileCache;
     }
     return *this;
 }
 ResponseBuilder::~ResponseBuilder() {}
 
+void ResponseBuilder::setOpenFileCache(OpenFileCache* cache) {
+    fileCache = cache;
+}
+
 HttpResponse ResponseBuilder::build(const RouteResult& resultRouter, CgiProcess* cgi, const VectorInt& openFds) {
     HttpResponse response;
 
@@ -23,6 +28,7 @@ HttpResponse ResponseBuilder::build(const RouteResult& resultRouter, CgiProcess*
 
     if (resultRouter.getStatusCode() != HTTP_OK) {
         handleError(response, resultRouter);
+        compressResponse(response, resultRouter);
         return response;
     }
 
@@ -46,19 +52,23 @@ HttpResponse ResponseBuilder::build(const RouteResult& resultRouter, CgiProcess*
         }
         handleError(response, errResult);
     }
+    compressResponse(response, resultRouter);
     return response;
 }
 
-HttpResponse ResponseBuilder::buildError(int code, const std::string& msg) {
+// Error for a request outside the routed flow; the route, when known,
+// selects the location/server error_page and the compression policy.
+HttpResponse ResponseBuilder::buildError(int code, const std::string& msg, const RouteResult& resultRouter) {
     HttpResponse response;
-    RouteResult  resultRouter;
-    resultRouter.setCodeAndMessage(code, msg);
-    handleError(response, resultRouter);
+    RouteResult  errResult = resultRouter;
+    errResult.setCodeAndMessage(code, msg);
+    handleError(response, errResult);
+    compressResponse(response, errResult);
     return response;
 }
 
 bool ResponseBuilder::handleStatic(HttpResponse& response, const RouteResult& resultRouter) const {
-    StaticFileHandler filehandler(mimeTypes);
+    StaticFileHandler filehandler(mimeTypes, fileCache);
     return filehandler.handle(resultRouter, response);
 }
 
@@ -89,7 +99,7 @@ bool ResponseBuilder::handleUpload(HttpResponse& response, const RouteResult& re
             fileContent = resultRouter.getRequest().getBody();
         }
     } else {
-        filename = extractFilenameFromHeader(resultRouter.getRequest().getHeader(HEADER_CONTENT_DISPOSITION));
+        filename = extractFilenameFromHeader(resultRouter.getRequest().getHeader(FIELD_CONTENT_DISPOSITION));
         if (filename.empty())
             filename = "upload_" + typeToString<time_t>(getCurrentTime()) + ".dat";
         fileContent = resultRouter.getRequest().getBody();
@@ -100,16 +110,8 @@ bool ResponseBuilder::handleUpload(HttpResponse& response, const RouteResult& re
 void ResponseBuilder::handleError(HttpResponse& response, const RouteResult& resultRouter) {
     ErrorPageHandler handler;
     handler.handle(response, resultRouter, mimeTypes);
-    if (resultRouter.getStatusCode() == HTTP_METHOD_NOT_ALLOWED && resultRouter.getLocation()) {
-        const VectorString& methods = resultRouter.getLocation()->getAllowedMethods();
-        String              allow;
-        for (size_t i = 0; i < methods.size(); ++i) {
-            if (i > 0)
-                allow += ", ";
-            allow += methods[i];
-        }
-        response.addHeader("Allow", allow);
-    }
+    if (resultRouter.getStatusCode() == HTTP_METHOD_NOT_ALLOWED && resultRouter.getLocation())
+        response.addHeader("Allow", joinStrings(resultRouter.getLocation()->getAllowedMethods(), ", "));
 }
 
 bool ResponseBuilder::handleCgi(HttpResponse& response, const RouteResult& resultRouter, CgiProcess* cgi, const VectorInt& openFds) const {
@@ -119,12 +121,66 @@ bool ResponseBuilder::handleCgi(HttpResponse& response, const RouteResult& resul
     return handler.handle(resultRouter, response, openFds);
 }
 
-HttpResponse ResponseBuilder::buildCgiResponse(CgiProcess& cgi) {
+HttpResponse ResponseBuilder::buildCgiResponse(CgiProcess& cgi, const RouteResult& resultRouter) {
     HttpResponse response;
-    if (CgiHandler::parseOutput(cgi.getOutput(), response))
+    if (CgiHandler::parseOutput(cgi.getOutput(), response)) {
         response.addHeader(HEADER_CONTENT_LENGTH, typeToString<size_t>(response.getBody().size()));
-    else
-        response = buildError(HTTP_INTERNAL_SERVER_ERROR, "CGI Error");
+        compressResponse(response, resultRouter);
+    } else
+        response = buildError(HTTP_INTERNAL_SERVER_ERROR, "CGI Error", resultRouter);
     cgi.reset();
     return response;
 }
+
+// gzip for generated bodies (CGI output, directory listings, error pages)
+// when the location enables it, the type is listed and the client accepts
+// it. Rendered bodies below gzip_min_length are left alone. The compressed
+// size is unknown until the end, so HTTP/1.1 responses switch to chunked
+// encoding and are compressed piece by piece as the socket drains; HTTP/1.0
+// ones are compressed up front. Static files are not touched (see
+// gzip_static).
+void ResponseBuilder::compressResponse(HttpResponse& response, const RouteResult& resultRouter) const {
+    const LocationConfig* loc     = resultRouter.getLocation();
+    const HttpRequest&    request = resultRouter.getRequest();
+    int                   status  = response.getStatusCode();
+    if (!loc || !loc->getGzip() || request.getMethod() == "HEAD" || status < HTTP_OK || status == HTTP_NO_CONTENT || status == HTTP_NOT_MODIFIED)
+        return;
+    if (!response.getHeader(HEADER_CONTENT_ENCODING).empty())
+        return;
+    String type = response.getHeader(HEADER_CONTENT_TYPE);
+    if (!loc->isGzipType(toLowerWords(trimSpaces(type.substr(0, type.find(';'))))))
+        return;
+    IBodySource*         source    = response.releaseBodySource();
+    GeneratorBodySource* generator = dynamic_cast<GeneratorBodySource*>(source);
+    if (source && !generator) {
+        response.setBodySource(source);
+        return;
+    }
+    response.addHeader(HEADER_VARY, HEADER_ACCEPT_ENCODING);
+    if (!acceptsEncoding(request.getHeader(FIELD_ACCEPT_ENCODING), "gzip") || (!generator && response.getBody().size() < loc->getGzipMinLength())) {
+        response.setBodySource(source);
+        return;
+    }
+
+    bool            chunked = request.getHttpVersion() != HTTP_VERSION_1_0;
+    GzipBodySource* gzip    = NULL;
+    if (generator)
+        gzip = new GzipBodySource(generator, loc->getGzipCompLevel(), chunked);
+    else {
+        String body;
+        response.takeBody(body);
+        gzip = new GzipBodySource(body, loc->getGzipCompLevel(), chunked);
+    }
+    response.addHeader(HEADER_CONTENT_ENCODING, "gzip");
+    response.removeHeader(HEADER_CONTENT_LENGTH);
+    if (chunked) {
+        response.addHeader(HEADER_TRANSFER_ENCODING, "chunked");
+        response.setBodySource(gzip);
+        return;
+    }
+    String compressed;
+    gzip->drain(compressed);
+    delete gzip;
+    response.addHeader(HEADER_CONTENT_LENGTH, typeToString<size_t>(compressed.size()));
+    response.setBody(compressed);
+}
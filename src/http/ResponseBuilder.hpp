@@ -11,6 +11,7 @@
 #include "../handlers/StaticFileHandler.hpp"
 #include "../handlers/UploaderHandler.hpp"
 #include "../utils/Utils.hpp"
+#include "GzipBodySource.hpp"
 #include "HttpResponse.hpp"
 #include "RouteResult.hpp"
 
@@ -23,11 +24,14 @@ class ResponseBuilder {
     ~ResponseBuilder();
 
     HttpResponse build(const RouteResult& resultRouter, CgiProcess* cgi = NULL, const VectorInt& openFds = VectorInt());
-    HttpResponse buildError(int code, const std::string& msg);
-    HttpResponse buildCgiResponse(CgiProcess& cgi);
+    HttpResponse buildError(int code, const std::string& msg, const RouteResult& resultRouter = RouteResult());
+    HttpResponse buildCgiResponse(CgiProcess& cgi, const RouteResult& resultRouter = RouteResult());
+    void         setOpenFileCache(OpenFileCache* cache);
+    void         compressResponse(HttpResponse& response, const RouteResult& resultRouter) const;
 
    private:
-    MimeTypes mimeTypes;
+    MimeTypes      mimeTypes;
+    OpenFileCache* fileCache; // owned by the event loop, may be NULL
 
     bool handleStatic(HttpResponse& response, const RouteResult& resultRouter) const;
     bool handleDelete(HttpResponse& response, const RouteResult& resultRouter) const;
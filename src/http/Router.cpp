@@ -1,16 +1,39 @@
 #include "Router.hpp"
 
-Router::Router() : _servers(NULL), _request() {}
-Router::Router(const VectorServerConfig& servers, const HttpRequest& request) : _servers(&servers), _request(request) {}
-Router::Router(const Router& other) : _servers(other._servers), _request(other._request) {}
+Router::Router() : _servers(NULL), _request(), _fileCache(NULL) {}
+Router::Router(const VectorServerConfig& servers, const HttpRequest& request, OpenFileCache* fileCache)
+    : _servers(&servers), _request(request), _fileCache(fileCache) {}
+Router::Router(const Router& other) : _servers(other._servers), _request(other._request), _fileCache(other._fileCache) {}
 Router& Router::operator=(const Router& other) {
     if (this != &other) {
-        _servers = other._servers;
-        _request = other._request;
+        _servers   = other._servers;
+        _request   = other._request;
+        _fileCache = other._fileCache;
     }
     return *this;
 }
 Router::~Router() {}
+
+// One stat() per path at most, none when the open file cache has it.
+bool Router::statPath(const String& path, FileType& type) const {
+    if (_fileCache && _fileCache->isEnabled()) {
+        const CachedFile* file = _fileCache->lookup(path, getCurrentTime());
+        if (!file)
+            return false;
+        type = file->type;
+        return true;
+    }
+    struct stat st;
+    if (stat(path.c_str(), &st) != 0)
+        return false;
+    type = getFileType(st);
+    return true;
+}
+
+bool Router::isRegularFile(const String& path) const {
+    FileType type;
+    return statPath(path, type) && type == SINGLEFILE;
+}
 void Router::resolveCgiScriptAndPathInfo(const LocationConfig* loc, String& scriptPath, String& pathInfo) const {
     scriptPath.clear();
     pathInfo.clear();
@@ -24,7 +47,7 @@ void Router::resolveCgiScriptAndPathInfo(const LocationConfig* loc, String& scri
     const String rest    = getUriRemainder(uri, locPath);
 
     String directFile = joinPaths(root, rest);
-    if (fileExists(directFile) && getFileType(directFile) == SINGLEFILE && isCgiRequest(directFile, *loc)) {
+    if (isRegularFile(directFile) && isCgiRequest(directFile, *loc)) {
         scriptPath = directFile;
         return;
     }
@@ -42,7 +65,7 @@ void Router::resolveCgiScriptAndPathInfo(const LocationConfig* loc, String& scri
         if (accumulated.empty()) continue;
         
         String candidate = joinPaths(root, accumulated);
-        if (fileExists(candidate) && getFileType(candidate) == SINGLEFILE && isCgiRequest(candidate, *loc)) {
+        if (isRegularFile(candidate) && isCgiRequest(candidate, *loc)) {
             scriptPath = candidate;
             if (rest.size() > accumulated.size()) {
                 pathInfo = rest.substr(accumulated.size());
@@ -109,17 +132,18 @@ RouteResult Router::processRequest() {
     }
 
     // 7. Resolve filesystem path for static/directory
-    String fsPath = resolveFilesystemPath(loc);
-    if (!fileExists(fsPath))
+    String   fsPath = resolveFilesystemPath(loc);
+    FileType fsType;
+    if (!statPath(fsPath, fsType))
         return result.setCodeAndMessage(HTTP_NOT_FOUND, getHttpStatusMessage(HTTP_NOT_FOUND));
 
     // If path is a directory, try to resolve index file
-    if (getFileType(fsPath) == DIRECTORY) {
+    if (fsType == DIRECTORY) {
         const VectorString& indexes    = loc->getIndexes();
         bool                foundIndex = false;
         for (size_t i = 0; i < indexes.size(); ++i) {
             String indexPath = joinPaths(fsPath, indexes[i]);
-            if (fileExists(indexPath) && getFileType(indexPath) == SINGLEFILE) {
+            if (isRegularFile(indexPath)) {
                 fsPath     = indexPath;
                 foundIndex = true;
                 break;
@@ -147,8 +171,6 @@ RouteResult Router::processRequest() {
         return result;
     }
 
-    if (!fileExists(fsPath))
-        return result.setCodeAndMessage(HTTP_NOT_FOUND, getHttpStatusMessage(HTTP_NOT_FOUND));
     result.setPathRootUri(fsPath);
 
     // 8. Determine handler type based on method and file type
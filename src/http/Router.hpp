@@ -7,6 +7,7 @@
 #include "../config/LocationConfig.hpp"
 #include "../config/ServerConfig.hpp"
 #include "../http/RouteResult.hpp"
+#include "../utils/OpenFileCache.hpp"
 #include "../utils/Utils.hpp"
 #include "HttpRequest.hpp"
 
@@ -15,7 +16,7 @@ class Router {
     Router();
     Router(const Router& other);
     Router& operator=(const Router& other);
-    Router(const VectorServerConfig& servers, const HttpRequest& request);
+    Router(const VectorServerConfig& servers, const HttpRequest& request, OpenFileCache* fileCache = NULL);
     ~Router();
 
     RouteResult processRequest();
@@ -27,8 +28,11 @@ class Router {
     String                resolveFilesystemPath(const LocationConfig* loc) const;
     bool                  isCgiRequest(const String& path, const LocationConfig& loc) const;
     void                  resolveCgiScriptAndPathInfo(const LocationConfig* loc, String& scriptPath, String& pathInfo) const;
+    bool                  statPath(const String& path, FileType& type) const;
+    bool                  isRegularFile(const String& path) const;
     const VectorServerConfig* _servers; // pointer to params from config (no copy)
     HttpRequest               _request; // param from http request
+    OpenFileCache*            _fileCache; // per-loop cache, NULL to always stat()
 };
 
 #endif
\ No newline at end of file
@@ -1,7 +1,9 @@
 #include <csignal>
 #include <iostream>
 #include "config/ConfigParser.hpp"
+#include "server/ReactorPool.hpp"
 #include "server/ServerManager.hpp"
+#include "server/WorkerSupervisor.hpp"
 #include "utils/Logger.hpp"
 
 volatile sig_atomic_t g_running = 0;
@@ -18,6 +20,52 @@ void setupSignals() {
     signal(SIGCHLD, SIG_IGN);
 }
 
+int runReactorPool(const VectorServerConfig& configs, const HttpConfig& httpConfig) {
+    ReactorPool pool(configs, httpConfig);
+    setupSignals();
+    if (!pool.initialize()) {
+        Logger::error("Failed to initialize reactor threads");
+        return 1;
+    }
+
+    Logger::info("\n========================================");
+    Logger::info("  Servers: " + typeToString(pool.getServerCount()));
+    Logger::info("  Reactor threads: " + typeToString(httpConfig.getWorkerThreads()));
+    Logger::info("Server Manager is running...");
+    Logger::info("========================================");
+
+    pool.run();
+
+    Logger::info("\n========================================");
+    Logger::info("       Server Stopped Successfully      ");
+    Logger::info("========================================");
+    return 0;
+}
+
+int runServer(const VectorServerConfig& configs, const HttpConfig& httpConfig) {
+    if (httpConfig.getWorkerThreads() > 1)
+        return runReactorPool(configs, httpConfig);
+
+    ServerManager serverManager(configs, httpConfig);
+    setupSignals();
+    if (!serverManager.initialize()) {
+        Logger::error("Failed to initialize server manager");
+        return 1;
+    }
+
+    Logger::info("\n========================================");
+    Logger::info("  Servers: " + typeToString(serverManager.getServerCount()));
+    Logger::info("Server Manager is running...");
+    Logger::info("========================================");
+
+    serverManager.run();
+
+    Logger::info("\n========================================");
+    Logger::info("       Server Stopped Successfully      ");
+    Logger::info("========================================");
+    return 0;
+}
+
 int main(int ac, char** av) {
     try {
         if(ac != 2) {
@@ -42,23 +90,11 @@ int main(int ac, char** av) {
             return 1;
         }
 
-        ServerManager serverManager(configs);
-        setupSignals();
-        if (!serverManager.initialize()) {
-            Logger::error("Failed to initialize server manager");
-            return 1;
+        if (parser.getHttpConfig().getWorkerProcesses() > 1) {
+            WorkerSupervisor supervisor(configs, parser.getHttpConfig(), runServer);
+            return supervisor.run() ? 0 : 1;
         }
-
-        Logger::info("\n========================================");
-        Logger::info("  Servers: " + typeToString(serverManager.getServerCount()));
-        Logger::info("Server Manager is running...");
-        Logger::info("========================================");
-
-        serverManager.run();
-
-        Logger::info("\n========================================");
-        Logger::info("       Server Stopped Successfully      ");
-        Logger::info("========================================");
+        return runServer(configs, parser.getHttpConfig());
     } catch (const std::exception& e) {
         Logger::error("Fatal error: " + String(e.what()));
         return 1;
@@ -1,36 +1,46 @@
 #include "Client.hpp"
 
-Client::Client() : client_fd(-1), _sendOffset(0), lastActivity(0), _keepAlive(false), _headersParsed(false) {}
+OutgoingResponse::OutgoingResponse() : statusLine(NULL), head(), body(), bodySource(NULL) {}
+
+size_t OutgoingResponse::size() const { return (statusLine ? statusLine->size() : 0) + head.size() + body.size(); }
+
+bool OutgoingResponse::isIdle() const { return !statusLine && head.empty() && body.empty() && !bodySource; }
+
+Client::Client()
+    : client_fd(-1), _responses(), _sendOffset(0), lastActivity(0), _keepAlive(false), remoteAddr(), _headersParsed(false) {}
 
 Client::Client(const Client& other)
     : client_fd(other.client_fd),
       storeReceiveData(other.storeReceiveData),
-      storeSendData(other.storeSendData),
+      _responses(),
       _sendOffset(other._sendOffset),
       lastActivity(other.lastActivity),
       _cgi(other._cgi),
       _keepAlive(other._keepAlive),
-      remoteAddress(other.remoteAddress),
+      remoteAddr(other.remoteAddr),
       _headersParsed(other._headersParsed),
-      _request(other._request) {}
+      _request(other._request) {
+    copyResponses(other);
+}
 
 Client& Client::operator=(const Client& other) {
     if (this != &other) {
         client_fd        = other.client_fd;
         storeReceiveData = other.storeReceiveData;
-        storeSendData    = other.storeSendData;
+        copyResponses(other);
         _sendOffset      = other._sendOffset;
         lastActivity     = other.lastActivity;
         _cgi             = other._cgi;
         _keepAlive       = other._keepAlive;
-        remoteAddress    = other.remoteAddress;
+        remoteAddr       = other.remoteAddr;
         _headersParsed   = other._headersParsed;
         _request         = other._request;
     }
     return *this;
 }
 
-Client::Client(int fd) : client_fd(fd), _sendOffset(0), _keepAlive(false), _headersParsed(false) {
+Client::Client(int fd)
+    : client_fd(fd), _responses(), _sendOffset(0), _keepAlive(false), remoteAddr(), _headersParsed(false) {
     lastActivity = getCurrentTime();
 }
 
@@ -40,12 +50,12 @@ Client::~Client() {
         _cgi.cleanup();
 }
 
+// Reads straight into the receive buffer's free tail.
 ssize_t Client::receiveData() {
-    char    tmp[BUFFER_SIZE];
     ssize_t total = 0;
     ssize_t n;
-    while ((n = read(client_fd, tmp, BUFFER_SIZE)) > 0) {
-        storeReceiveData.append(tmp, n);
+    while ((n = read(client_fd, storeReceiveData.prepare(BUFFER_SIZE), BUFFER_SIZE)) > 0) {
+        storeReceiveData.commit(n);
         total += n;
         if (storeReceiveData.size() > BUFFER_SIZE)
             break;
@@ -57,39 +67,157 @@ ssize_t Client::receiveData() {
     return n;
 }
 
-ssize_t Client::sendData() {
-    if (_sendOffset >= storeSendData.size())
-        return 0;
-    size_t  totalSent = 0;
-    while (_sendOffset < storeSendData.size() && totalSent < BUFFER_SIZE) {
-        size_t  remaining = storeSendData.size() - _sendOffset;
-        ssize_t sent = write(client_fd, storeSendData.c_str() + _sendOffset, remaining);
-        if (sent > 0) {
-            _sendOffset += sent;
-            totalSent   += sent;
-        } else {
+// Body sources are owned, so a copy clones them.
+void Client::copyResponses(const Client& other) {
+    clearResponses();
+    _responses = other._responses;
+    for (size_t i = 0; i < _responses.size(); ++i)
+        if (_responses[i].bodySource)
+            _responses[i].bodySource = _responses[i].bodySource->clone();
+}
+
+// Slot for the next response: the idle front when nothing is queued, so its
+// buffers are reused, otherwise a new entry behind the pipelined ones.
+OutgoingResponse& Client::nextResponse() {
+    if (_responses.empty() || !_responses.front().isIdle())
+        _responses.push_back(OutgoingResponse());
+    return _responses.back();
+}
+
+// The front response is fully written. The last one stays as the idle slot.
+void Client::finishFront() {
+    OutgoingResponse& front = _responses.front();
+    delete front.bodySource;
+    front.bodySource = NULL;
+    _sendOffset      = 0;
+    if (_responses.size() > 1) {
+        _responses.pop_front();
+        return;
+    }
+    front.statusLine = NULL;
+    front.head.clear();
+    releaseIfLarger(front.body, CLIENT_BUFFER_RETAIN);
+}
+
+void Client::clearResponses() {
+    while (!_responses.empty() && !_responses.front().isIdle())
+        finishFront();
+    _sendOffset = 0;
+}
+
+// Status lines, heads and bodies of the queued responses as iovecs, skipping
+// what has already been sent. A response with a body source ends the batch:
+// its stream has to go out before anything queued after it.
+int Client::buildIovec(struct iovec* iov, int max) const {
+    size_t skip  = _sendOffset;
+    int    count = 0;
+    for (size_t r = 0; r < _responses.size() && count + 3 <= max; ++r) {
+        const OutgoingResponse& response = _responses[r];
+        const String*           parts[3] = {response.statusLine, &response.head, &response.body};
+        for (int i = 0; i < 3; ++i) {
+            if (!parts[i])
+                continue;
+            size_t len = parts[i]->size();
+            if (skip >= len) {
+                skip -= len;
+                continue;
+            }
+            iov[count].iov_base = const_cast<char*>(parts[i]->data() + skip);
+            iov[count].iov_len  = len - skip;
+            skip                = 0;
+            ++count;
+        }
+        if (response.bodySource)
             break;
+    }
+    return count;
+}
+
+// Moves past `sent` bytes, retiring every response written completely.
+void Client::advance(size_t sent) {
+    while (sent > 0 && !_responses.empty()) {
+        OutgoingResponse& front = _responses.front();
+        size_t            left  = front.size() - _sendOffset;
+        if (sent < left || front.bodySource) {
+            _sendOffset += minValue(sent, left);
+            return;
         }
+        sent -= left;
+        finishFront();
     }
-    if (_sendOffset >= storeSendData.size()) {
-        storeSendData.clear();
-        _sendOffset = 0;
+}
+
+// Writes queued responses in order: as many as fit in one writev() per
+// call, then at most SEND_CHUNK_SIZE bytes of a body source, so a large
+// body cannot starve the other connections of the loop.
+ssize_t Client::sendData() {
+    size_t totalSent = 0;
+    while (totalSent < BUFFER_SIZE && hasPendingSend()) {
+        OutgoingResponse& front = _responses.front();
+        if (_sendOffset < front.size()) {
+            struct iovec iov[SEND_IOV_MAX];
+            ssize_t      sent = writev(client_fd, iov, buildIovec(iov, SEND_IOV_MAX));
+            if (sent <= 0)
+                break;
+            advance(sent);
+            totalSent += sent;
+            continue;
+        }
+        if (!front.bodySource) {
+            finishFront();
+            continue;
+        }
+        ssize_t sent = front.bodySource->writeTo(client_fd, SEND_CHUNK_SIZE);
+        if (sent < 0)
+            return -1;
+        totalSent += sent;
+        if (!front.bodySource->isDone())
+            break;
+        finishFront();
     }
     if (totalSent > 0)
         updateTime(lastActivity);
     return totalSent;
 }
 
-void Client::setSendData(const String& data) {
-    size_t firstLineEnd = data.find("\r\n");
-    if (firstLineEnd != String::npos)
-        Logger::info("Setting send data for client " + typeToString(client_fd) + ": " + data.substr(0, firstLineEnd));
-    storeSendData = data;
-    _sendOffset   = 0;
+bool Client::hasPendingSend() const {
+    return !_responses.empty() && !_responses.front().isIdle();
 }
 
-void Client::setRemoteAddress(const String& address) {
-    remoteAddress = address;
+// Responses queued and not yet fully written, the one in flight included.
+size_t Client::getQueuedResponses() const {
+    return hasPendingSend() ? _responses.size() : 0;
+}
+
+// Queues a response without concatenating it: the status line is sent from
+// the static table, the head is rendered into the slot's reused head and
+// the body is taken over by swap. Responses to pipelined requests queue up
+// behind the one being sent.
+void Client::queueResponse(HttpResponse& response, const HttpDate& date) {
+    OutgoingResponse& out = nextResponse();
+    out.statusLine        = response.getStatusLine();
+    response.appendHead(out.head, date, out.statusLine == NULL);
+    response.takeBody(out.body);
+    out.bodySource     = response.releaseBodySource();
+    const String& head = out.statusLine ? *out.statusLine : out.head;
+    Logger::info("Setting send data for client " + typeToString(client_fd) + ": " + head.substr(0, head.find("\r\n")));
+}
+
+// A content cache hit: only the prologue, Connection and any per-request
+// extraHeaders are rendered; the cached headers and body are copied into
+// the slot's body, whose capacity is kept across responses, so no
+// allocation or file read is involved.
+void Client::queueCachedResponse(const CachedContent& content, bool headOnly, const HttpDate& date, const String& extraHeaders) {
+    OutgoingResponse& out = nextResponse();
+    out.statusLine        = &HttpResponse::statusLine(content.status);
+    out.head.append(date.getPrologue()).append("Connection: ").append(_keepAlive ? "keep-alive" : "close").append(CRLF);
+    out.head.append(extraHeaders);
+    out.body.assign(content.wire, 0, headOnly ? content.headLength : content.wire.size());
+    Logger::info("Setting send data for client " + typeToString(client_fd) + ": " + out.statusLine->substr(0, out.statusLine->size() - 2) + " (cached)");
+}
+
+void Client::setRemoteAddress(const sockaddr_in& address) {
+    remoteAddr = address;
 }
 
 void Client::clearStoreReceiveData() {
@@ -97,34 +225,58 @@ void Client::clearStoreReceiveData() {
 }
 
 void Client::removeReceivedData(size_t len) {
-    if (len >= storeReceiveData.size())
-        storeReceiveData.clear();
-    else
-        storeReceiveData.erase(0, len);
+    storeReceiveData.consume(len);
 }
 
-bool Client::isTimedOut(int timeout) const {
-    return getElapsedSeconds(lastActivity, getCurrentTime()) > timeout;
+time_t Client::getLastActivity() const {
+    return lastActivity;
 }
 
 void Client::closeConnection() {
+    clearResponses();
     if (client_fd != -1) {
         close(client_fd);
         client_fd = -1;
     }
 }
 
-const String& Client::getStoreReceiveData() const { return storeReceiveData; }
+// Pooled reuse: bind a recycled object to a freshly accepted socket.
+void Client::attach(int fd) {
+    client_fd      = fd;
+    _sendOffset    = 0;
+    _keepAlive     = false;
+    _headersParsed = false;
+    std::memset(&remoteAddr, 0, sizeof(remoteAddr));
+    updateTime(lastActivity);
+}
 
-const String& Client::getStoreSendData() const {
-    static const String empty;
-    return _sendOffset >= storeSendData.size() ? empty : storeSendData;
+// Returns the object to its pooled state. Buffers keep their capacity up to
+// CLIENT_BUFFER_RETAIN so the next connection does not start from scratch.
+void Client::recycle() {
+    closeConnection();
+    if (_cgi.isActive())
+        _cgi.cleanup();
+    _cgi.reset();
+    _cgi.releaseBuffers(CLIENT_BUFFER_RETAIN);
+    storeReceiveData.release(CLIENT_BUFFER_RETAIN);
+    if (!_responses.empty())
+        releaseIfLarger(_responses.front().head, CLIENT_BUFFER_RETAIN);
+    _request.releaseBuffers(CLIENT_BUFFER_RETAIN);
+    _sendOffset    = 0;
+    _keepAlive     = false;
+    _headersParsed = false;
+    lastActivity   = 0;
 }
 
+const ReceiveBuffer& Client::getStoreReceiveData() const { return storeReceiveData; }
+
 int Client::getFd() const { return client_fd; }
 CgiProcess& Client::getCgi() { return _cgi; }
 const CgiProcess& Client::getCgi() const { return _cgi; }
-String Client::getRemoteAddress() const { return remoteAddress; }
+String Client::getRemoteAddress() const {
+    const unsigned char* ip = reinterpret_cast<const unsigned char*>(&remoteAddr.sin_addr.s_addr);
+    return typeToString<int>(ip[0]) + "." + typeToString<int>(ip[1]) + "." + typeToString<int>(ip[2]) + "." + typeToString<int>(ip[3]);
+}
 bool Client::isHeadersParsed() const { return _headersParsed; }
 void Client::setHeadersParsed(bool parsed) { _headersParsed = parsed; }
 
@@ -142,7 +294,7 @@ bool Client::isKeepAlive() const { return _keepAlive; }
 void Client::refreshActivity() { updateTime(lastActivity); }
 
 bool Client::isChunkedEncoding() const {
-    return toLowerWords(_request.getHeader("transfer-encoding")).find("chunked") != String::npos;
+    return _request.hasHeaderToken(FIELD_TRANSFER_ENCODING, "chunked");
 }
 
 const String& Client::getMethod() const { return _request.getMethod(); }
@@ -1,26 +1,55 @@
 #ifndef CLIENT_HPP
 #define CLIENT_HPP
 
+#include <netinet/in.h>
+#include <sys/uio.h>
 #include <sys/types.h>
 #include <unistd.h>
+#include <cstring>
 #include <ctime>
+#include <deque>
 #include <iostream>
 #include "../handlers/CgiProcess.hpp"
+#include "../http/ContentCache.hpp"
 #include "../http/HttpRequest.hpp"
+#include "../http/HttpResponse.hpp"
+#include "../http/IBodySource.hpp"
 #include "../utils/Utils.hpp"
+#include "ReceiveBuffer.hpp"
+
+// A response waiting to be written: status line, head and body go out with
+// writev(), then the body source, if any, is streamed.
+struct OutgoingResponse {
+    const String* statusLine; // prebuilt line in HttpResponse's table, not owned
+    String        head;       // rendered head, reused across responses
+    String        body;       // rendered body taken from the response
+    IBodySource*  bodySource; // owned by the Client; pulled once the rest is sent
+
+    OutgoingResponse();
+    size_t size() const;
+    bool   isIdle() const;
+};
+
 class Client {
    private:
-    int         client_fd;
-    String      storeReceiveData;
-    String      storeSendData;
-    size_t      _sendOffset;
+    int                          client_fd;
+    ReceiveBuffer                storeReceiveData;
+    std::deque<OutgoingResponse> _responses;  // front is being sent, the rest are pipelined
+    size_t                       _sendOffset; // across the front's status line + head + body
     time_t      lastActivity;
     CgiProcess  _cgi;
     bool        _keepAlive;
-    String      remoteAddress;
+    sockaddr_in remoteAddr; // kept binary; formatted only on demand
     bool        _headersParsed;
     HttpRequest _request;
 
+    OutgoingResponse& nextResponse();
+    void              finishFront();
+    void              clearResponses();
+    void              copyResponses(const Client& other);
+    void              advance(size_t sent);
+    int               buildIovec(struct iovec* iov, int max) const;
+
    public:
     Client(const Client&);
     Client& operator=(const Client&);
@@ -30,14 +59,18 @@ class Client {
 
     ssize_t       receiveData();
     ssize_t       sendData();
-    void          setSendData(const String& data);
-    void          setRemoteAddress(const String& address);
+    void          queueResponse(HttpResponse& response, const HttpDate& date);
+    void          queueCachedResponse(const CachedContent& content, bool headOnly, const HttpDate& date, const String& extraHeaders);
+    bool          hasPendingSend() const;
+    size_t        getQueuedResponses() const;
+    void          setRemoteAddress(const sockaddr_in& address);
     void          clearStoreReceiveData();
-    bool          isTimedOut(int timeout) const;
+    time_t        getLastActivity() const;
     void          closeConnection();
+    void          attach(int fd);
+    void          recycle();
     void          removeReceivedData(size_t len);
-    const String& getStoreReceiveData() const;
-    const String& getStoreSendData() const;
+    const ReceiveBuffer& getStoreReceiveData() const;
     int           getFd() const;
     String        getRemoteAddress() const;
     bool          isHeadersParsed() const;
@@ -0,0 +1,41 @@
+#include "ClientPool.hpp"
+
+ClientPool::ClientPool() : slab(), freeList() {}
+
+ClientPool::~ClientPool() {}
+
+// Called once before the event loop starts; the slab is never resized
+// afterwards, so handed-out pointers stay valid.
+void ClientPool::init(size_t capacity) {
+    freeList.clear();
+    slab.clear();
+    slab.resize(capacity);
+    freeList.reserve(capacity);
+    for (size_t i = capacity; i > 0; i--)
+        freeList.push_back(&slab[i - 1]);
+}
+
+// Returns NULL when every slot is in use.
+Client* ClientPool::acquire(int fd) {
+    if (freeList.empty())
+        return NULL;
+    Client* client = freeList.back();
+    freeList.pop_back();
+    client->attach(fd);
+    return client;
+}
+
+void ClientPool::release(Client* client) {
+    if (!client)
+        return;
+    client->recycle();
+    freeList.push_back(client);
+}
+
+size_t ClientPool::capacity() const {
+    return slab.size();
+}
+
+size_t ClientPool::inUse() const {
+    return slab.size() - freeList.size();
+}
@@ -0,0 +1,30 @@
+#ifndef CLIENT_POOL_HPP
+#define CLIENT_POOL_HPP
+
+#include <cstddef>
+#include <vector>
+#include "Client.hpp"
+
+// Fixed slab of Client objects sized by worker_connections. Accepting and
+// closing a connection only moves a pointer on and off the free list; the
+// objects and their buffers are reused instead of being new'd and deleted.
+class ClientPool {
+   public:
+    ClientPool();
+    ~ClientPool();
+
+    void    init(size_t capacity);
+    Client* acquire(int fd);
+    void    release(Client* client);
+    size_t  capacity() const;
+    size_t  inUse() const;
+
+   private:
+    ClientPool(const ClientPool&);
+    ClientPool& operator=(const ClientPool&);
+
+    std::vector<Client>  slab;
+    std::vector<Client*> freeList;
+};
+
+#endif
@@ -0,0 +1,103 @@
+#include "EpollEventBackend.hpp"
+#include <unistd.h>
+#include <cerrno>
+#include "../utils/Utils.hpp"
+
+EpollEventBackend::EpollEventBackend() : _epollFd(INVALID_FD) {}
+
+EpollEventBackend::~EpollEventBackend() {
+    if (_epollFd != INVALID_FD)
+        close(_epollFd);
+}
+
+#ifdef __linux__
+
+static int toEpollEvents(int events) {
+    int result = 0;
+    if (events & POLLIN)
+        result |= EPOLLIN;
+    if (events & POLLOUT)
+        result |= EPOLLOUT;
+    return result;
+}
+
+static int toPollEvents(int events) {
+    int result = 0;
+    if (events & EPOLLIN)
+        result |= POLLIN;
+    if (events & EPOLLOUT)
+        result |= POLLOUT;
+    if (events & EPOLLERR)
+        result |= POLLERR;
+    if (events & EPOLLHUP)
+        result |= POLLHUP;
+    return result;
+}
+
+bool EpollEventBackend::init() {
+    _epollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (_epollFd < 0)
+        return Logger::error("epoll_create1 failed");
+    _events.resize(EPOLL_MAX_EVENTS);
+    return true;
+}
+
+bool EpollEventBackend::control(int op, int fd, int events) {
+    struct epoll_event ev;
+    ev.events  = toEpollEvents(events);
+    ev.data.u64 = 0;
+    ev.data.fd = fd;
+    return epoll_ctl(_epollFd, op, fd, &ev) == 0;
+}
+
+bool EpollEventBackend::add(int fd, int events) {
+    if (control(EPOLL_CTL_ADD, fd, events))
+        return true;
+    return errno == EEXIST && control(EPOLL_CTL_MOD, fd, events);
+}
+
+bool EpollEventBackend::modify(int fd, int events) {
+    if (control(EPOLL_CTL_MOD, fd, events))
+        return true;
+    return errno == ENOENT && control(EPOLL_CTL_ADD, fd, events);
+}
+
+void EpollEventBackend::remove(int fd) {
+    struct epoll_event ev;
+    ev.events   = 0;
+    ev.data.u64 = 0;
+    epoll_ctl(_epollFd, EPOLL_CTL_DEL, fd, &ev);
+}
+
+int EpollEventBackend::wait(VectorReadyEvent& ready, int timeout) {
+    ready.clear();
+    int count = epoll_wait(_epollFd, &_events[0], _events.size(), timeout);
+    for (int i = 0; i < count; i++) {
+        ReadyEvent ev;
+        ev.fd      = _events[i].data.fd;
+        ev.revents = toPollEvents(_events[i].events);
+        ready.push_back(ev);
+    }
+    return count;
+}
+
+#else
+
+bool EpollEventBackend::init() {
+    return Logger::error("epoll is not available on this platform");
+}
+
+bool EpollEventBackend::control(int, int, int) { return false; }
+bool EpollEventBackend::add(int, int) { return false; }
+bool EpollEventBackend::modify(int, int) { return false; }
+void EpollEventBackend::remove(int) {}
+int  EpollEventBackend::wait(VectorReadyEvent& ready, int) {
+    ready.clear();
+    return -1;
+}
+
+#endif
+
+const char* EpollEventBackend::getName() const {
+    return "epoll";
+}
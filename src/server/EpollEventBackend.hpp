@@ -0,0 +1,36 @@
+#ifndef EPOLL_EVENT_BACKEND_HPP
+#define EPOLL_EVENT_BACKEND_HPP
+
+#include <vector>
+#include "IEventBackend.hpp"
+#ifdef __linux__
+#include <sys/epoll.h>
+#endif
+
+// Level-triggered epoll: the handlers cap each read/write at BUFFER_SIZE and rely on being
+// woken up again while data is still pending, which edge-triggered mode would not do.
+class EpollEventBackend : public IEventBackend {
+   private:
+    int _epollFd;
+#ifdef __linux__
+    std::vector<struct epoll_event> _events;
+#endif
+
+    EpollEventBackend(const EpollEventBackend&);
+    EpollEventBackend& operator=(const EpollEventBackend&);
+
+    bool control(int op, int fd, int events);
+
+   public:
+    EpollEventBackend();
+    ~EpollEventBackend();
+
+    bool        init();
+    bool        add(int fd, int events);
+    bool        modify(int fd, int events);
+    void        remove(int fd);
+    int         wait(VectorReadyEvent& ready, int timeout);
+    const char* getName() const;
+};
+
+#endif
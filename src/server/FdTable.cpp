@@ -0,0 +1,62 @@
+#include "FdTable.hpp"
+
+static const FdEntry EMPTY_ENTRY = {FD_NONE, NULL, NULL};
+
+FdTable::FdTable() : entries() {}
+
+FdTable::FdTable(const FdTable& other) : entries(other.entries) {}
+
+FdTable& FdTable::operator=(const FdTable& other) {
+    if (this != &other)
+        entries = other.entries;
+    return *this;
+}
+
+FdTable::~FdTable() {}
+
+void FdTable::setListener(int fd, Server* server) {
+    FdEntry& entry = slot(fd);
+    entry.role     = FD_LISTENER;
+    entry.client   = NULL;
+    entry.server   = server;
+}
+
+void FdTable::setClient(int fd, Client* client, Server* server) {
+    FdEntry& entry = slot(fd);
+    entry.role     = FD_CLIENT;
+    entry.client   = client;
+    entry.server   = server;
+}
+
+void FdTable::setCgiPipe(int fd, FdRole role, Client* client) {
+    FdEntry& entry = slot(fd);
+    entry.role     = role;
+    entry.client   = client;
+    entry.server   = NULL;
+}
+
+void FdTable::clear(int fd) {
+    if (fd >= 0 && static_cast<size_t>(fd) < entries.size())
+        entries[fd] = EMPTY_ENTRY;
+}
+
+const FdEntry& FdTable::get(int fd) const {
+    if (fd < 0 || static_cast<size_t>(fd) >= entries.size())
+        return EMPTY_ENTRY;
+    return entries[fd];
+}
+
+Client* FdTable::getClient(int fd) const {
+    const FdEntry& entry = get(fd);
+    return entry.role == FD_CLIENT ? entry.client : NULL;
+}
+
+size_t FdTable::capacity() const {
+    return entries.size();
+}
+
+FdEntry& FdTable::slot(int fd) {
+    if (static_cast<size_t>(fd) >= entries.size())
+        entries.resize(fd + 1, EMPTY_ENTRY);
+    return entries[fd];
+}
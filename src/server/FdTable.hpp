@@ -0,0 +1,40 @@
+#ifndef FD_TABLE_HPP
+#define FD_TABLE_HPP
+
+#include <cstddef>
+#include <vector>
+#include "../utils/Enums.hpp"
+#include "../utils/Types.hpp"
+
+// What a descriptor is and who owns it. For CGI pipes `client` is the
+// client the CGI runs for; for clients `server` is the accepting listener.
+struct FdEntry {
+    FdRole  role;
+    Client* client;
+    Server* server;
+};
+
+// Dense fd-indexed table: descriptors are small integers, so dispatch on a
+// ready fd is a single vector load instead of several map lookups.
+class FdTable {
+   public:
+    FdTable();
+    FdTable(const FdTable& other);
+    FdTable& operator=(const FdTable& other);
+    ~FdTable();
+
+    void           setListener(int fd, Server* server);
+    void           setClient(int fd, Client* client, Server* server);
+    void           setCgiPipe(int fd, FdRole role, Client* client);
+    void           clear(int fd);
+    const FdEntry& get(int fd) const;
+    Client*        getClient(int fd) const;
+    size_t         capacity() const;
+
+   private:
+    std::vector<FdEntry> entries;
+
+    FdEntry& slot(int fd);
+};
+
+#endif
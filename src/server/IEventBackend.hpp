@@ -0,0 +1,25 @@
+#ifndef I_EVENT_BACKEND_HPP
+#define I_EVENT_BACKEND_HPP
+#include <poll.h>
+#include <vector>
+
+// Events are always expressed with the poll(2) flags (POLLIN, POLLOUT, POLLERR, POLLHUP),
+// each backend translates them to its own representation.
+struct ReadyEvent {
+    int fd;
+    int revents;
+};
+typedef std::vector<ReadyEvent> VectorReadyEvent;
+
+class IEventBackend {
+   public:
+    virtual ~IEventBackend() {}
+    virtual bool        init()                                  = 0;
+    virtual bool        add(int fd, int events)                 = 0;
+    virtual bool        modify(int fd, int events)              = 0;
+    virtual void        remove(int fd)                          = 0;
+    virtual int         wait(VectorReadyEvent& ready, int timeout) = 0;
+    virtual const char* getName() const                         = 0;
+};
+
+#endif
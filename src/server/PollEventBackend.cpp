@@ -0,0 +1,74 @@
+#include "PollEventBackend.hpp"
+
+PollEventBackend::PollEventBackend() {}
+
+PollEventBackend::~PollEventBackend() {
+    fds.clear();
+    _fdIndex.clear();
+}
+
+bool PollEventBackend::init() {
+    return true;
+}
+
+bool PollEventBackend::add(int fd, int events) {
+    if (fd < static_cast<int>(_fdIndex.size()) && _fdIndex[fd] >= 0)
+        return modify(fd, events);
+    if (static_cast<size_t>(fd) >= _fdIndex.size())
+        _fdIndex.resize(fd + 1, -1);
+
+    struct pollfd pfd;
+    pfd.fd       = fd;
+    pfd.events   = events;
+    pfd.revents  = 0;
+    _fdIndex[fd] = fds.size();
+    fds.push_back(pfd);
+    return true;
+}
+
+bool PollEventBackend::modify(int fd, int events) {
+    if (fd >= static_cast<int>(_fdIndex.size()) || _fdIndex[fd] < 0)
+        return add(fd, events);
+    fds[_fdIndex[fd]].events  = events;
+    fds[_fdIndex[fd]].revents = 0;
+    return true;
+}
+
+void PollEventBackend::remove(int fd) {
+    if (fd < 0 || fd >= static_cast<int>(_fdIndex.size()) || _fdIndex[fd] < 0)
+        return;
+
+    size_t index = _fdIndex[fd];
+    _fdIndex[fd] = -1;
+    if (index < fds.size() - 1) {
+        fds[index]              = fds.back();
+        _fdIndex[fds[index].fd] = index;
+    }
+    fds.pop_back();
+}
+
+int PollEventBackend::wait(VectorReadyEvent& ready, int timeout) {
+    ready.clear();
+    if (fds.empty())
+        return 0;
+
+    for (size_t i = 0; i < fds.size(); i++)
+        fds[i].revents = 0;
+
+    int count = poll(&fds[0], fds.size(), timeout);
+    if (count <= 0)
+        return count;
+    for (size_t i = 0; i < fds.size() && (int)ready.size() < count; i++) {
+        if (fds[i].revents == 0)
+            continue;
+        ReadyEvent ev;
+        ev.fd      = fds[i].fd;
+        ev.revents = fds[i].revents;
+        ready.push_back(ev);
+    }
+    return ready.size();
+}
+
+const char* PollEventBackend::getName() const {
+    return "poll";
+}
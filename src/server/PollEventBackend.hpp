@@ -0,0 +1,29 @@
+#ifndef POLL_EVENT_BACKEND_HPP
+#define POLL_EVENT_BACKEND_HPP
+
+#include <poll.h>
+#include <cstddef>
+#include <vector>
+#include "IEventBackend.hpp"
+
+class PollEventBackend : public IEventBackend {
+   private:
+    std::vector<struct pollfd> fds;
+    std::vector<int>           _fdIndex; // fd -> position in fds, -1 when absent
+
+    PollEventBackend(const PollEventBackend&);
+    PollEventBackend& operator=(const PollEventBackend&);
+
+   public:
+    PollEventBackend();
+    ~PollEventBackend();
+
+    bool        init();
+    bool        add(int fd, int events);
+    bool        modify(int fd, int events);
+    void        remove(int fd);
+    int         wait(VectorReadyEvent& ready, int timeout);
+    const char* getName() const;
+};
+
+#endif
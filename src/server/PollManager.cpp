@@ -1,95 +1,107 @@
 #include "PollManager.hpp"
+#include "../utils/Logger.hpp"
+#include "EpollEventBackend.hpp"
+#include "PollEventBackend.hpp"
 
-PollManager::PollManager(const PollManager& other) : fds(other.fds), _fdIndex(other._fdIndex) {}
+PollManager::PollManager() : _backend(NULL), _events(), _count(0), _ready() {}
 
-PollManager& PollManager::operator=(const PollManager& other) {
-    if (this != &other) {
-        fds      = other.fds;
-        _fdIndex = other._fdIndex;
-    }
-    return *this;
+PollManager::~PollManager() {
+    delete _backend;
+    _events.clear();
+    _ready.clear();
 }
 
-PollManager::PollManager() {}
-
-PollManager::~PollManager() {
-    fds.clear();
-    _fdIndex.clear();
+bool PollManager::init(EventBackendType type) {
+    delete _backend;
+    _backend = NULL;
+    if (type == BACKEND_EPOLL) {
+        _backend = new EpollEventBackend();
+        if (!_backend->init()) {
+            Logger::error("epoll backend unavailable, falling back to poll");
+            delete _backend;
+            _backend = NULL;
+        }
+    }
+    if (!_backend) {
+        _backend = new PollEventBackend();
+        if (!_backend->init())
+            return Logger::error("Failed to initialize poll backend");
+    }
+    for (size_t fd = 0; fd < _events.size(); fd++)
+        if (_events[fd] >= 0)
+            _backend->add(fd, _events[fd]);
+    return Logger::info("Event backend: " + String(getBackendName()));
 }
 
 void PollManager::addFd(int fd, int events) {
     if (fd < 0)
         return;
-
-    std::map<int, size_t>::iterator it = _fdIndex.find(fd);
-    if (it != _fdIndex.end()) {
-        size_t idx       = it->second;
-        fds[idx].events  = events;
-        fds[idx].revents = 0;
+    if (!_backend)
+        init(BACKEND_POLL);
+
+    if (static_cast<size_t>(fd) >= _events.size())
+        _events.resize(fd + 1, -1);
+    if (_events[fd] >= 0) {
+        if (_events[fd] != events)
+            _backend->modify(fd, events);
+        _events[fd] = events;
         return;
     }
-
-    struct pollfd pfd;
-    pfd.fd      = fd;
-    pfd.events  = events;
-    pfd.revents = 0;
-    _fdIndex[fd] = fds.size();
-    fds.push_back(pfd);
-}
-
-void PollManager::removeFd(size_t index) {
-    if (index >= fds.size())
-        return;
-
-    int removedFd = fds[index].fd;
-    _fdIndex.erase(removedFd);
-    if (index < fds.size() - 1) {
-        fds[index] = fds.back();
-        _fdIndex[fds[index].fd] = index;
-    }
-    fds.pop_back();
+    _events[fd] = events;
+    _count++;
+    _backend->add(fd, events);
 }
 
 void PollManager::removeFdByValue(int fd) {
-    std::map<int, size_t>::iterator it = _fdIndex.find(fd);
-    if (it != _fdIndex.end())
-        removeFd(it->second);
+    if (!isFdRegistered(fd))
+        return;
+    _events[fd] = -1;
+    _count--;
+    _backend->remove(fd);
+    // the fd number may be reused before the ready list is fully processed
+    for (size_t i = 0; i < _ready.size(); i++)
+        if (_ready[i].fd == fd)
+            _ready[i].fd = -1;
 }
 
 int PollManager::pollConnections(int timeout) {
-    if (fds.empty())
+    if (!_backend) {
+        _ready.clear();
         return 0;
-
-    for (size_t i = 0; i < fds.size(); i++) {
-        fds[i].revents = 0;
     }
+    return _backend->wait(_ready, timeout);
+}
 
-    return poll(&fds[0], fds.size(), timeout);
+size_t PollManager::getReadyCount() const {
+    return _ready.size();
 }
 
 bool PollManager::hasEvent(size_t index, int event) const {
-    if (index >= fds.size())
+    if (index >= _ready.size())
         return false;
-    return (fds[index].revents & event) != 0;
+    return (_ready[index].revents & event) != 0;
 }
 
 int PollManager::getFd(size_t index) const {
-    if (index >= fds.size())
+    if (index >= _ready.size())
         return -1;
-    return fds[index].fd;
+    return _ready[index].fd;
 }
 
 int PollManager::getEvents(int fd) const {
-    std::map<int, size_t>::const_iterator it = _fdIndex.find(fd);
-    if (it != _fdIndex.end())
-        return fds[it->second].events;
-    return 0;
+    if (!isFdRegistered(fd))
+        return 0;
+    return _events[fd];
 }
 
 bool PollManager::isFdRegistered(int fd) const {
-    return _fdIndex.count(fd) > 0;
+    return fd >= 0 && static_cast<size_t>(fd) < _events.size() && _events[fd] >= 0;
 }
 
 size_t PollManager::size() const {
-    return fds.size();
+    return _count;
+}
+
+const char* PollManager::getBackendName() const {
+    return _backend ? _backend->getName() : "none";
 }
@@ -3,29 +3,35 @@
 
 #include <poll.h>
 #include <cstddef>
-#include <map>
 #include <vector>
+#include "../utils/Enums.hpp"
 #include "../utils/Types.hpp"
+#include "IEventBackend.hpp"
 
 class PollManager {
    private:
-    std::vector<struct pollfd> fds;
-    std::map<int, size_t>     _fdIndex;
+    IEventBackend*   _backend;
+    VectorInt        _events;  // fd -> requested events, -1 when not registered
+    size_t           _count;   // number of registered fds
+    VectorReadyEvent _ready;   // fds reported by the last pollConnections()
 
-   public:
     PollManager(const PollManager&);
     PollManager& operator=(const PollManager&);
+
+   public:
     PollManager();
     ~PollManager();
-    void      addFd(int fd, int events);
-    void      removeFd(size_t index);
-    void      removeFdByValue(int fd);
-    int       pollConnections(int timeout);
-    bool      hasEvent(size_t index, int event) const;
-    int       getFd(size_t index) const;
-    int       getEvents(int fd) const;
-    bool      isFdRegistered(int fd) const;
-    size_t    size() const;
+    bool        init(EventBackendType type);
+    void        addFd(int fd, int events);
+    void        removeFdByValue(int fd);
+    int         pollConnections(int timeout);
+    size_t      getReadyCount() const;
+    bool        hasEvent(size_t index, int event) const;
+    int         getFd(size_t index) const;
+    int         getEvents(int fd) const;
+    bool        isFdRegistered(int fd) const;
+    size_t      size() const;
+    const char* getBackendName() const;
 };
 
-#endif
\ No newline at end of file
+#endif
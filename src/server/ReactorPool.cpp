@@ -0,0 +1,88 @@
+#include "ReactorPool.hpp"
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+
+ReactorPool::ReactorPool(const VectorServerConfig& configs, const HttpConfig& _httpConfig)
+    : serverConfigs(configs), httpConfig(_httpConfig), sessionManager(), managers() {
+    wakeupPipe[0] = INVALID_FD;
+    wakeupPipe[1] = INVALID_FD;
+}
+
+ReactorPool::~ReactorPool() {
+    for (size_t i = 0; i < managers.size(); i++)
+        delete managers[i];
+    managers.clear();
+    for (size_t i = 0; i < 2; i++)
+        if (wakeupPipe[i] != INVALID_FD)
+            close(wakeupPipe[i]);
+}
+
+bool ReactorPool::initialize() {
+    size_t count = httpConfig.getWorkerThreads();
+    if (pipe(wakeupPipe) != 0)
+        return Logger::error("Failed to create reactor wakeup pipe");
+    for (size_t i = 0; i < 2; i++)
+        fcntl(wakeupPipe[i], F_SETFD, FD_CLOEXEC);
+    setNonBlocking(wakeupPipe[1]);
+    for (size_t i = 0; i < count; i++) {
+        ServerManager* manager = new ServerManager(serverConfigs, httpConfig, sessionManager);
+        managers.push_back(manager);
+        if (!manager->initialize())
+            return Logger::error("Failed to initialize reactor thread " + typeToString(i));
+        manager->watchWakeupFd(wakeupPipe[0]);
+    }
+    return Logger::info("Reactor pool initialized with " + typeToString(count) + " threads");
+}
+
+void* ReactorPool::threadMain(void* arg) {
+    ServerManager* manager = static_cast<ServerManager*>(arg);
+    try {
+        manager->run();
+    } catch (const std::exception& e) {
+        Logger::error("Reactor thread fatal error: " + String(e.what()));
+    } catch (...) {
+        Logger::error("Reactor thread fatal unknown error");
+    }
+    return NULL;
+}
+
+// Shutdown signals are kept on the calling thread; the other loops notice
+// g_running on their next wakeup.
+bool ReactorPool::run() {
+    sigset_t blocked, previous;
+    sigemptyset(&blocked);
+    sigaddset(&blocked, SIGINT);
+    sigaddset(&blocked, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &blocked, &previous);
+
+    std::vector<pthread_t> threads;
+    for (size_t i = 1; i < managers.size(); i++) {
+        pthread_t thread;
+        if (pthread_create(&thread, NULL, threadMain, managers[i]) != 0) {
+            Logger::error("Failed to start reactor thread " + typeToString(i));
+            g_running = 0;
+            break;
+        }
+        threads.push_back(thread);
+    }
+    pthread_sigmask(SIG_SETMASK, &previous, NULL);
+
+    if (g_running && !managers.empty())
+        threadMain(managers[0]);
+    g_running = 0;
+    wakeAll();
+    for (size_t i = 0; i < threads.size(); i++)
+        pthread_join(threads[i], NULL);
+    return true;
+}
+
+// The byte is never drained, so the pipe stays readable for every loop.
+void ReactorPool::wakeAll() {
+    if (wakeupPipe[1] != INVALID_FD && write(wakeupPipe[1], "x", 1) < 0)
+        Logger::error("Failed to wake reactor threads");
+}
+
+size_t ReactorPool::getServerCount() const {
+    return managers.empty() ? 0 : managers[0]->getServerCount();
+}
@@ -0,0 +1,40 @@
+#ifndef REACTOR_POOL_HPP
+#define REACTOR_POOL_HPP
+
+#include <pthread.h>
+#include <vector>
+#include "../config/HttpConfig.hpp"
+#include "../config/ServerConfig.hpp"
+#include "../utils/SessionManager.hpp"
+#include "ServerManager.hpp"
+
+// worker_threads mode: one ServerManager per thread, each with its own
+// PollManager, clients and CGI pipes. Like worker processes, every thread
+// binds its own SO_REUSEPORT listeners, so the kernel hands each new
+// connection to one loop instead of waking all of them. Sessions are shared
+// through one locked SessionManager. A pipe watched by every loop wakes
+// them all on shutdown.
+class ReactorPool {
+   public:
+    ReactorPool(const VectorServerConfig& configs, const HttpConfig& httpConfig);
+    ~ReactorPool();
+
+    bool   initialize();
+    bool   run();
+    size_t getServerCount() const;
+
+   private:
+    ReactorPool(const ReactorPool&);
+    ReactorPool& operator=(const ReactorPool&);
+
+    const VectorServerConfig    serverConfigs;
+    const HttpConfig            httpConfig;
+    SessionManager              sessionManager;
+    std::vector<ServerManager*> managers;
+    int                         wakeupPipe[2];
+
+    void         wakeAll();
+    static void* threadMain(void* arg);
+};
+
+#endif
@@ -0,0 +1,60 @@
+#include "ReceiveBuffer.hpp"
+
+ReceiveBuffer::ReceiveBuffer() : storage(), start(0), end(0) {}
+
+ReceiveBuffer::ReceiveBuffer(const ReceiveBuffer& other) : storage(other.storage), start(other.start), end(other.end) {}
+
+ReceiveBuffer& ReceiveBuffer::operator=(const ReceiveBuffer& other) {
+    if (this != &other) {
+        storage = other.storage;
+        start   = other.start;
+        end     = other.end;
+    }
+    return *this;
+}
+
+ReceiveBuffer::~ReceiveBuffer() {}
+
+// Room for at least `length` bytes after the received data.
+char* ReceiveBuffer::prepare(size_t length) {
+    if (storage.size() - end < length) {
+        if (start > 0) {
+            std::memmove(&storage[0], &storage[start], end - start);
+            end -= start;
+            start = 0;
+        }
+        if (storage.size() - end < length || end * 2 > storage.size())
+            storage.resize(std::max(storage.size() * 2, end + length));
+    }
+    return &storage[end];
+}
+
+void ReceiveBuffer::commit(size_t length) { end += length; }
+
+void ReceiveBuffer::consume(size_t length) {
+    if (length >= end - start)
+        clear();
+    else
+        start += length;
+}
+
+void ReceiveBuffer::clear() {
+    start = 0;
+    end   = 0;
+}
+
+void ReceiveBuffer::release(size_t maxCapacity) {
+    if (storage.capacity() > maxCapacity)
+        std::vector<char>().swap(storage);
+    clear();
+}
+
+const char* ReceiveBuffer::data() const { return storage.empty() ? "" : &storage[start]; }
+size_t ReceiveBuffer::size() const { return end - start; }
+bool ReceiveBuffer::empty() const { return start == end; }
+
+String ReceiveBuffer::substr(size_t pos, size_t length) const {
+    if (pos >= size())
+        return String();
+    return String(data() + pos, minValue(length, size() - pos));
+}
@@ -0,0 +1,38 @@
+#ifndef RECEIVE_BUFFER_HPP
+#define RECEIVE_BUFFER_HPP
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+#include "../utils/Utils.hpp"
+
+// Receive-side byte queue of one connection. read() writes straight into
+// the free tail (prepare() then commit()), and consume() only advances the
+// read cursor. The unread bytes are moved back to the front only when the
+// tail runs short, and the storage doubles whenever they would still fill
+// more than half of it, so each byte is moved a bounded number of times
+// however requests and body chunks are consumed.
+class ReceiveBuffer {
+   public:
+    ReceiveBuffer();
+    ReceiveBuffer(const ReceiveBuffer& other);
+    ReceiveBuffer& operator=(const ReceiveBuffer& other);
+    ~ReceiveBuffer();
+
+    char*       prepare(size_t length);
+    void        commit(size_t length);
+    void        consume(size_t length);
+    void        clear();
+    void        release(size_t maxCapacity);
+    const char* data() const;
+    size_t      size() const;
+    bool        empty() const;
+    String      substr(size_t pos, size_t length) const;
+
+   private:
+    std::vector<char> storage;
+    size_t            start; // first unread byte
+    size_t            end;   // one past the last received byte
+};
+
+#endif
@@ -75,26 +75,33 @@ void Server::stop() {
     running = false;
 }
 
-int Server::acceptConnection(String& remoteAddress) {
+// The accepted socket comes back non-blocking and close-on-exec in a single
+// syscall where accept4() is available.
+int Server::acceptConnection(struct sockaddr_in& remoteAddr) {
     if (!running || server_fd == -1) {
         Logger::error("Cannot accept connection: server not running");
         return -1;
     }
 
-    sockaddr_in addr;
-    socklen_t   addr_len  = sizeof(addr);
-    int         client_fd = accept(server_fd, (sockaddr*)&addr, &addr_len);
+    socklen_t addr_len = sizeof(remoteAddr);
+#ifdef __linux__
+    int client_fd = accept4(server_fd, (sockaddr*)&remoteAddr, &addr_len, SOCK_NONBLOCK | SOCK_CLOEXEC);
+#else
+    int client_fd = accept(server_fd, (sockaddr*)&remoteAddr, &addr_len);
+#endif
     if (client_fd < 0) {
-        Logger::error("Failed to accept new connection");
+        // backlog drained
+        if (errno != EAGAIN && errno != EWOULDBLOCK)
+            Logger::error("Failed to accept new connection");
         return -1;
     }
+#ifndef __linux__
     if (!setNonBlocking(client_fd)) {
         close(client_fd);
         Logger::error("Failed to set non-blocking mode for client socket");
         return -1;
     }
-    unsigned char* ip = (unsigned char*)&addr.sin_addr.s_addr;
-    remoteAddress     = typeToString<int>(ip[0]) + "." + typeToString<int>(ip[1]) + "." + typeToString<int>(ip[2]) + "." + typeToString<int>(ip[3]);
+#endif
     return client_fd;
 }
 
@@ -6,6 +6,7 @@
 #include <netinet/in.h>
 #include <sys/socket.h>
 #include <unistd.h>
+#include <cerrno>
 #include <cstring>
 #include <iostream>
 #include <sstream>
@@ -34,7 +35,7 @@ class Server {
 
     bool init();
     void stop();
-    int  acceptConnection(String& remoteAddress);
+    int  acceptConnection(struct sockaddr_in& remoteAddr);
 
     // getters
     int          getFd() const;
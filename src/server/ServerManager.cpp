@@ -1,10 +1,46 @@
 #include "ServerManager.hpp"
 
 ServerManager::ServerManager()
-    : pollManager(), servers(), serverConfigs(), clients(), clientToServer(), serverToConfigs(), mimeTypes(), sessionManager() {}
+    : pollManager(), servers(), serverConfigs(), httpConfig(), fdTable(), clientPool(), serverToConfigs(), mimeTypes(), localSessions(), sessionManager(localSessions), timers(), httpDate(), openFileCache(), contentCache(), errorPages(), nextSessionCleanup(0) {}
 
 ServerManager::ServerManager(const VectorServerConfig& _configs)
-    : pollManager(), servers(), serverConfigs(_configs), clients(), clientToServer(), serverToConfigs(), mimeTypes(), sessionManager() {}
+    : pollManager(), servers(), serverConfigs(_configs), httpConfig(), fdTable(), clientPool(), serverToConfigs(), mimeTypes(), localSessions(), sessionManager(localSessions), timers(), httpDate(), openFileCache(), contentCache(), errorPages(), nextSessionCleanup(0) {}
+
+ServerManager::ServerManager(const VectorServerConfig& _configs, const HttpConfig& _httpConfig)
+    : pollManager(),
+      servers(),
+      serverConfigs(_configs),
+      httpConfig(_httpConfig),
+      fdTable(),
+      clientPool(),
+      serverToConfigs(),
+      mimeTypes(),
+      localSessions(),
+      sessionManager(localSessions),
+      timers(),
+      httpDate(),
+      openFileCache(),
+      contentCache(),
+      errorPages(),
+      nextSessionCleanup(0) {}
+
+ServerManager::ServerManager(const VectorServerConfig& _configs, const HttpConfig& _httpConfig, SessionManager& sharedSessions)
+    : pollManager(),
+      servers(),
+      serverConfigs(_configs),
+      httpConfig(_httpConfig),
+      fdTable(),
+      clientPool(),
+      serverToConfigs(),
+      mimeTypes(),
+      localSessions(),
+      sessionManager(sharedSessions),
+      timers(),
+      httpDate(),
+      openFileCache(),
+      contentCache(),
+      errorPages(),
+      nextSessionCleanup(0) {}
 
 ServerManager::~ServerManager() {
     shutdown();
@@ -13,12 +49,28 @@ ServerManager::~ServerManager() {
 bool ServerManager::initialize() {
     if (serverConfigs.empty())
         return Logger::error("No server configurations provided");
+    if (!pollManager.init(httpConfig.getEventBackend()))
+        return Logger::error("Failed to initialize event backend");
+    clientPool.init(httpConfig.getWorkerConnections());
+    configureCaches();
     if (!initializeServers(serverConfigs) || servers.empty())
         return Logger::error("Failed to initialize servers");
     g_running = 1;
     return Logger::info("[INFO]: ServerManager initialized");
 }
 
+void ServerManager::configureCaches() {
+    openFileCache.configure(httpConfig.getOpenFileCacheMax(), httpConfig.getOpenFileCacheInactive(), httpConfig.getOpenFileCacheValid());
+    responseBuilder.setOpenFileCache(&openFileCache);
+    contentCache.configure(httpConfig.getContentCacheSize(), httpConfig.getContentCacheMaxFile(), mimeTypes, &openFileCache);
+    errorPages.build(serverConfigs, mimeTypes);
+}
+
+// The fd is only watched so that it interrupts the wait; run() ignores it.
+void ServerManager::watchWakeupFd(int fd) {
+    pollManager.addFd(fd, POLLIN);
+}
+
 ListenerToConfigsMap ServerManager::mapListenersToConfigs(const VectorServerConfig& serversConfigs) {
     ListenerToConfigsMap result;
     for (size_t i = 0; i < serversConfigs.size(); i++) {
@@ -72,23 +124,29 @@ bool ServerManager::initializeServers(const VectorServerConfig& serversConfigs)
             continue;
         servers.push_back(server);
         serverToConfigs[server->getFd()] = it->second;
-        serverFdMap[server->getFd()]     = server;
+        fdTable.setListener(server->getFd(), server);
     }
     return !servers.empty();
 }
 
 bool ServerManager::run() {
-    time_t lastSessionCleanup = getCurrentTime();
+    nextSessionCleanup = getCurrentTime() + SESSION_CLEANUP_INTERVAL;
     while (g_running) {
-        int eventCount = pollManager.pollConnections(POLL_TIMEOUT_MS);
-        checkTimeouts(CLIENT_TIMEOUT);
-        if (getElapsedSeconds(lastSessionCleanup, getCurrentTime()) > SESSION_CLEANUP_INTERVAL) {
+        int    eventCount = pollManager.pollConnections(computePollTimeout(getCurrentTime()));
+        time_t now        = getCurrentTime();
+        httpDate.refresh(now);
+        processTimers(now);
+        openFileCache.expire(now);
+        if (now >= nextSessionCleanup) {
             sessionManager.cleanupExpiredSessions(SESSION_TIMEOUT);
-            lastSessionCleanup = getCurrentTime();
+            if (contentCache.isEnabled())
+                Logger::info("Content cache: " + typeToString(contentCache.getHits()) + " hits, " + typeToString(contentCache.getMisses())
+                             + " misses, " + typeToString(contentCache.size()) + " entries, " + formatSize(contentCache.getBytes()));
+            nextSessionCleanup = now + SESSION_CLEANUP_INTERVAL;
         }
         if (eventCount <= 0)
             continue;
-        for (size_t i = 0; i < pollManager.size() && eventCount > 0; i++) {
+        for (size_t i = 0; i < pollManager.getReadyCount(); i++) {
             int fd = pollManager.getFd(i);
             if (fd < 0)
                 continue;
@@ -98,68 +156,78 @@ bool ServerManager::run() {
             if (!hasIn && !hasOut && !hasErr)
                 continue;
             try {
-                if (hasIn) {
-                    if (isCgiPipe(fd))
-                        handleCgiRead(fd);
-                    else if (isServerSocket(fd))
-                        acceptNewConnection(findServerByFd(fd));
-                    else if (clients.count(fd))
-                        handleClientRead(fd);
-                }
-                if (hasOut) {
-                    if (isCgiPipe(fd))
-                        handleCgiWrite(fd);
-                    else if (clients.count(fd))
-                        handleClientWrite(fd);
-                }
-                if (hasErr && !hasIn && !hasOut) {
-                    if (isCgiPipe(fd))
-                        handleCgiRead(fd);
-                    else if (clients.count(fd))
-                        closeClientConnection(fd);
-                }
-                eventCount--;
+                dispatchEvent(fd, hasIn, hasOut, hasErr);
             } catch (const std::exception& e) {
                 Logger::error("Exception on fd " + typeToString(fd) + ": " + e.what());
-                if (!isServerSocket(fd) && !isCgiPipe(fd) && clients.count(fd))
+                if (fdTable.get(fd).role == FD_CLIENT)
                     closeClientConnection(fd);
             }
-            if (i < pollManager.size() && pollManager.getFd(i) != fd)
-                --i;
         }
     }
     return true;
 }
 
-bool ServerManager::acceptNewConnection(Server* server) {
-    if (clients.size() >= MAX_CONNECTIONS) {
-        Logger::error("Max connections reached (" + typeToString(MAX_CONNECTIONS) + "), rejecting new connection");
-        String remoteAddress;
-        int    tmpFd = server->acceptConnection(remoteAddress);
-        if (tmpFd >= 0)
-            close(tmpFd);
-        return false;
+void ServerManager::dispatchEvent(int fd, bool hasIn, bool hasOut, bool hasErr) {
+    // copied: handlers may grow the table and invalidate references into it
+    const FdEntry entry = fdTable.get(fd);
+    switch (entry.role) {
+        case FD_LISTENER:
+            if (hasIn)
+                acceptNewConnection(entry.server);
+            break;
+        case FD_CLIENT:
+            if (hasIn)
+                handleClientRead(fd);
+            // the read may have closed the connection
+            if (hasOut && fdTable.get(fd).role == FD_CLIENT)
+                handleClientWrite(fd);
+            if (hasErr && !hasIn && !hasOut)
+                closeClientConnection(fd);
+            break;
+        case FD_CGI_STDOUT:
+            if (hasIn || hasErr)
+                handleCgiRead(fd);
+            break;
+        case FD_CGI_STDIN:
+            if (hasOut)
+                handleCgiWrite(fd);
+            else if (hasErr) {
+                // the script stopped reading its body; stop feeding it
+                removeCgiPipe(fd);
+                entry.client->getCgi().closeWriteFd();
+            }
+            break;
+        default:
+            break;
     }
-    String remoteAddress;
-    int    clientFd = server->acceptConnection(remoteAddress);
-    if (clientFd < 0)
-        return false;
-    Client* client;
-    try {
-        client = new Client(clientFd);
-    } catch (...) {
-        close(clientFd);
-        return false;
+}
+
+// Drains the listen backlog until accept() would block or the per-wakeup
+// budget is spent; with level-triggered readiness anything left over is
+// picked up on the next iteration.
+bool ServerManager::acceptNewConnection(Server* server) {
+    size_t budget = httpConfig.getAcceptBudget();
+    for (size_t accepted = 0; accepted < budget; accepted++) {
+        sockaddr_in remoteAddr;
+        int         clientFd = server->acceptConnection(remoteAddr);
+        if (clientFd < 0)
+            break;
+        Client* client = clientPool.acquire(clientFd);
+        if (!client) {
+            Logger::error("Max connections reached (" + typeToString(clientPool.capacity()) + "), rejecting new connection");
+            close(clientFd);
+            continue;
+        }
+        client->setRemoteAddress(remoteAddr);
+        fdTable.setClient(clientFd, client, server);
+        pollManager.addFd(clientFd, POLLIN);
+        timers.schedule(clientFd, clientDeadline(client));
     }
-    client->setRemoteAddress(remoteAddress);
-    clients[clientFd]        = client;
-    clientToServer[clientFd] = server;
-    pollManager.addFd(clientFd, POLLIN);
     return true;
 }
 
 void ServerManager::handleClientRead(int clientFd) {
-    Client* client = getValue(clients, clientFd, (Client*)NULL);
+    Client* client = fdTable.getClient(clientFd);
     if (!client) {
         closeClientConnection(clientFd);
         return;
@@ -171,60 +239,122 @@ void ServerManager::handleClientRead(int clientFd) {
     }
     if (received < 0)
         return;
-    Server* server = getValue(clientToServer, clientFd, (Server*)NULL);
+    Server* server = fdTable.get(clientFd).server;
     if (server)
         processRequest(client, server);
 }
 
 void ServerManager::handleClientWrite(int clientFd) {
-    Client* client = getValue(clients, clientFd, (Client*)NULL);
+    Client* client = fdTable.getClient(clientFd);
     if (!client || client->sendData() < 0)
         return closeClientConnection(clientFd);
-    if (!client->getStoreSendData().empty())
-        return;
-    if (client->isKeepAlive())
+    if (!client->hasPendingSend()) {
+        if (!client->isKeepAlive())
+            return closeClientConnection(clientFd);
         pollManager.addFd(clientFd, POLLIN);
-    else
-        closeClientConnection(clientFd);
+    }
+    resumePipeline(client);
 }
 
-void ServerManager::checkTimeouts(int timeout) {
-    std::vector<int> toClose;
-    for (MapIntClientPtr::iterator it = clients.begin(); it != clients.end(); ++it) {
-        if (it->second->getCgi().isActive()) {
-            if (getElapsedSeconds(it->second->getCgi().getStartTime(), getCurrentTime()) > CGI_TIMEOUT) {
-                cleanupClientCgi(it->second);
-                it->second->setSendData(responseBuilder.buildError(HTTP_GATEWAY_TIMEOUT, "CGI Timeout").toString());
-                it->second->resetForNextRequest();
-                clientRoutes.erase(it->first);
-                pollManager.addFd(it->first, POLLIN | POLLOUT);
-            }
-        } else if (it->second->isTimedOut(timeout)) {
-            toClose.push_back(it->first);
+// Activity only bumps timestamps (Client::lastActivity, CgiProcess start
+// time); the real deadline is recomputed here when the wheel fires and the
+// client is re-armed if it was active in the meantime.
+void ServerManager::processTimers(time_t now) {
+    VectorInt expired;
+    timers.advance(now, expired);
+    for (size_t i = 0; i < expired.size(); i++) {
+        int     fd     = expired[i];
+        Client* client = fdTable.getClient(fd);
+        if (!client)
+            continue;
+        time_t deadline = clientDeadline(client);
+        if (deadline > now) {
+            timers.schedule(fd, deadline);
+            continue;
+        }
+        if (!client->getCgi().isActive()) {
+            closeClientConnection(fd);
+            continue;
         }
+        cleanupClientCgi(client);
+        HttpResponse timeout = responseBuilder.buildError(HTTP_GATEWAY_TIMEOUT, "CGI Timeout", getValue(clientRoutes, fd, RouteResult()));
+        client->queueResponse(timeout, httpDate);
+        client->resetForNextRequest();
+        client->refreshActivity();
+        clientRoutes.erase(fd);
+        pollManager.addFd(fd, POLLIN | POLLOUT);
+        timers.schedule(fd, clientDeadline(client));
     }
-    for (size_t i = 0; i < toClose.size(); i++)
-        closeClientConnection(toClose[i]);
 }
 
-void ServerManager::sendErrorResponse(Client* client, int statusCode, const String& message, bool closeConn, size_t bytesToRemove) {
-    HttpResponse response = responseBuilder.buildError(statusCode, message);
-    response.addHeader("Connection", closeConn ? "close" : "keep-alive");
+time_t ServerManager::clientDeadline(Client* client) const {
+    if (client->getCgi().isActive())
+        return client->getCgi().getStartTime() + CGI_TIMEOUT + 1;
+    return client->getLastActivity() + CLIENT_TIMEOUT + 1;
+}
+
+// Sleep until the next timer or session sweep is due. Shutdown does not need
+// a periodic wakeup: signals interrupt the wait and ReactorPool threads are
+// woken through their wakeup pipe.
+int ServerManager::computePollTimeout(time_t now) const {
+    time_t due  = nextSessionCleanup;
+    time_t next = timers.nextDeadline();
+    if (next != 0 && next < due)
+        due = next;
+    if (due <= now)
+        return 0;
+    time_t wait = due - now;
+    if (wait >= MAX_POLL_TIMEOUT_MS / 1000)
+        return MAX_POLL_TIMEOUT_MS;
+    return static_cast<int>(wait * 1000);
+}
+
+// The pre-rendered page for an error, queued as one buffer. A custom reason
+// phrase or a gzip location needs a rendered response instead.
+bool ServerManager::queueCachedError(Client* client, int statusCode, const String& message, const RouteResult* route) {
+    RouteResult           none;
+    const RouteResult&    res = route ? *route : none;
+    const LocationConfig* loc = res.getLocation();
+    if (message != getHttpStatusMessage(statusCode) || (loc && loc->getGzip()))
+        return false;
+    const CachedContent* page = errorPages.find(res, statusCode);
+    if (!page)
+        return false;
+    String allow;
+    if (statusCode == HTTP_METHOD_NOT_ALLOWED && loc)
+        allow = String("Allow: ") + joinStrings(loc->getAllowedMethods(), ", ") + CRLF;
+    client->queueCachedResponse(*page, client->getRequest().getMethod() == "HEAD", httpDate, allow);
+    return true;
+}
+
+void ServerManager::sendErrorResponse(Client* client, int statusCode, const String& message, bool closeConn, size_t bytesToRemove,
+                                      const RouteResult* route) {
     if (closeConn) {
         client->setKeepAlive(false);
         client->clearStoreReceiveData();
     } else if (bytesToRemove > 0) {
         client->removeReceivedData(bytesToRemove);
     }
-    client->setSendData(response.toString());
+    if (!queueCachedError(client, statusCode, message, route)) {
+        HttpResponse response = responseBuilder.buildError(statusCode, message, route ? *route : RouteResult());
+        response.addHeader("Connection", closeConn ? "close" : "keep-alive");
+        client->queueResponse(response, httpDate);
+    }
     client->resetForNextRequest();
     clientRoutes.erase(client->getFd());
     pollManager.addFd(client->getFd(), POLLIN | POLLOUT);
 }
 
+// Answers every complete request in the receive buffer. Responses to
+// pipelined requests queue up in order on the client; once pipeline_depth
+// of them are waiting, reading stops until handleClientWrite() drains some.
 void ServerManager::processRequest(Client* client, Server* server) {
     while (true) {
         if (!client->isHeadersParsed()) {
+            if (client->getQueuedResponses() >= httpConfig.getPipelineDepth()) {
+                pollManager.addFd(client->getFd(), POLLOUT);
+                return;
+            }
             if (!parseAndRouteHeaders(client, server))
                 return;
             continue;
@@ -235,9 +365,26 @@ void ServerManager::processRequest(Client* client, Server* server) {
         }
         if (!handleRegularBody(client))
             return;
+        // requests after a "Connection: close" one are not answered
+        if (!client->isKeepAlive())
+            return;
     }
 }
 
+// Picks up requests that were left in the receive buffer while the response
+// queue was full or a CGI response was pending, and resumes reading.
+void ServerManager::resumePipeline(Client* client) {
+    int fd = client->getFd();
+    if (!client->isKeepAlive() || client->getCgi().isActive() || client->getQueuedResponses() >= httpConfig.getPipelineDepth())
+        return;
+    int events = pollManager.getEvents(fd);
+    if (!(events & POLLIN))
+        pollManager.addFd(fd, events | POLLIN);
+    Server* server = fdTable.get(fd).server;
+    if (server && !client->getStoreReceiveData().empty())
+        processRequest(client, server);
+}
+
 ssize_t ServerManager::getMaxBodySize(const RouteResult& res) const {
     ssize_t maxBody = INVALID_FD;
     if (res.getLocation())
@@ -247,10 +394,45 @@ ssize_t ServerManager::getMaxBodySize(const RouteResult& res) const {
     return maxBody;
 }
 
-void ServerManager::finalizeResponse(Client* client, const HttpResponse& response, ssize_t bodyLen) {
-    HttpResponse resp = response;
-    resp.addHeader("Connection", client->isKeepAlive() ? "keep-alive" : "close");
-    client->setSendData(resp.toString());
+void ServerManager::finalizeResponse(Client* client, HttpResponse& response, ssize_t bodyLen) {
+    response.addHeader("Connection", client->isKeepAlive() ? "keep-alive" : "close");
+    client->queueResponse(response, httpDate);
+    completeRequest(client, bodyLen);
+}
+
+// GET/HEAD of a small static file answered from the content cache, skipping
+// the handler, the MIME lookup and the HttpResponse entirely.
+bool ServerManager::serveFromContentCache(Client* client, const RouteResult& res, ssize_t bodyLen) {
+    if (!contentCache.isEnabled() || res.getHandlerType() != STATIC || res.getStatusCode() != HTTP_OK || res.getIsRedirect())
+        return false;
+    const String& method = res.getRequest().getMethod();
+    if (method != "GET" && method != "HEAD")
+        return false;
+    // entries are not keyed by encoding: negotiated responses skip the cache
+    const LocationConfig* loc = res.getLocation();
+    if (loc && (loc->getGzipStatic() || loc->getBrotliStatic()))
+        return false;
+    // conditional and range requests may need a 304 or 206, which
+    // StaticFileHandler answers
+    const HttpRequest& request = res.getRequest();
+    if (request.hasHeader(FIELD_IF_NONE_MATCH) || request.hasHeader(FIELD_IF_MODIFIED_SINCE) || request.hasHeader(FIELD_RANGE))
+        return false;
+    const CachedContent* content = contentCache.lookup(res.getPathRootUri(), getCurrentTime());
+    if (!content)
+        return false;
+    // Expires is relative to now, so cache headers are not part of the entry
+    String cacheHeaders;
+    if (loc) {
+        HttpResponse policy;
+        policy.setCacheHeaders(loc->getExpires(content->type), loc->getCacheControl(content->type));
+        policy.appendHeaders(cacheHeaders);
+    }
+    client->queueCachedResponse(*content, method == "HEAD", httpDate, cacheHeaders);
+    completeRequest(client, bodyLen);
+    return true;
+}
+
+void ServerManager::completeRequest(Client* client, ssize_t bodyLen) {
     client->removeReceivedData(bodyLen);
     client->resetForNextRequest();
     clientRoutes.erase(client->getFd());
@@ -258,49 +440,45 @@ void ServerManager::finalizeResponse(Client* client, const HttpResponse& respons
 }
 
 bool ServerManager::parseAndRouteHeaders(Client* client, Server* server) {
-    const String& buffer = client->getStoreReceiveData();
+    const ReceiveBuffer& buffer = client->getStoreReceiveData();
+    const char*          data   = buffer.data();
     if (buffer.empty())
         return false;
 
-    if (buffer[0] == '\r' || buffer[0] == '\n') {
+    if (data[0] == '\r' || data[0] == '\n') {
         size_t start = 0;
-        while (start < buffer.size() && (buffer[start] == '\r' || buffer[start] == '\n'))
+        while (start < buffer.size() && (data[start] == '\r' || data[start] == '\n'))
             start++;
         client->removeReceivedData(start);
         return true;
     }
 
-    size_t headerEnd    = buffer.find(DOUBLE_CRLF);
-    size_t headerEndLen = 4;
-    if (headerEnd == String::npos) {
-        headerEnd    = buffer.find("\n\n");
-        headerEndLen = 2;
-    }
-    if (headerEnd == String::npos) {
-        if (buffer.size() > MAX_HEADER_SIZE) {
+    // the scan resumes where the previous read stopped
+    size_t headLength = 0;
+    if (!client->getRequest().scanHead(data, buffer.size(), headLength)) {
+        if (buffer.size() > MAX_HEADER_SIZE)
             sendErrorResponse(client, HTTP_REQUEST_HEADER_FIELDS_TOO_LARGE, getHttpStatusMessage(HTTP_REQUEST_HEADER_FIELDS_TOO_LARGE), true, 0);
-            return false;
-        }
         return false;
     }
-    if (headerEnd > MAX_HEADER_SIZE) {
+    if (headLength > MAX_HEADER_SIZE) {
         sendErrorResponse(client, HTTP_REQUEST_HEADER_FIELDS_TOO_LARGE, getHttpStatusMessage(HTTP_REQUEST_HEADER_FIELDS_TOO_LARGE), true,
-                          headerEnd + headerEndLen);
+                          headLength);
         return false;
     }
 
-    if (!client->getRequest().parseHeaders(buffer.substr(0, headerEnd))) {
-        sendErrorResponse(client, client->getErrorCode(), getHttpStatusMessage(client->getErrorCode()), true, headerEnd + headerEndLen);
+    if (!client->getRequest().parseHead(data, headLength)) {
+        sendErrorResponse(client, client->getErrorCode(), getHttpStatusMessage(client->getErrorCode()), true, headLength);
         return false;
     }
     client->getRequest().setPort(server->getPort());
     parseConnectionHeader(client);
     client->setHeadersParsed(true);
-    client->removeReceivedData(headerEnd + headerEndLen);
+    client->removeReceivedData(headLength);
 
-    Router      router(serverToConfigs[server->getFd()], client->getRequest());
+    Router      router(serverToConfigs[server->getFd()], client->getRequest(), &openFileCache);
     RouteResult res = router.processRequest();
-    res.setRemoteAddress(client->getRemoteAddress());
+    if (res.getHandlerType() == CGI)
+        res.setRemoteAddress(client->getRemoteAddress());
     clientRoutes[client->getFd()] = res;
 
     if (res.getStatusCode() >= 400) {
@@ -308,7 +486,7 @@ bool ServerManager::parseAndRouteHeaders(Client* client, Server* server) {
         return false;
     }
 
-    bool hasContentLength = !client->getRequest().getHeader(HEADER_CONTENT_LENGTH).empty();
+    bool hasContentLength = client->getRequest().hasHeader(FIELD_CONTENT_LENGTH);
     bool isChunked        = client->isChunkedEncoding();
 
     if (!validateRequestBody(client, res, hasContentLength, isChunked))
@@ -326,25 +504,17 @@ bool ServerManager::parseAndRouteHeaders(Client* client, Server* server) {
 }
 
 void ServerManager::parseConnectionHeader(Client* client) {
-    bool   keepAlive = (client->getRequest().getHttpVersion() == HTTP_VERSION_1_1);
-    String conn      = toLowerWords(client->getRequest().getHeader(HEADER_CONNECTION));
-
-    VectorString connValues;
-    if (splitByString(conn, connValues, ",")) {
-        for (size_t i = 0; i < connValues.size(); i++) {
-            String val = trimSpaces(connValues[i]);
-            if (val == CLOSE) {
-                keepAlive = false;
-                break;
-            } else if (val == KEEP_ALIVE)
-                keepAlive = true;
-        }
-    }
+    const HttpRequest& request   = client->getRequest();
+    bool               keepAlive = (request.getHttpVersion() == HTTP_VERSION_1_1);
+    if (request.hasHeaderToken(FIELD_CONNECTION, CLOSE))
+        keepAlive = false;
+    else if (request.hasHeaderToken(FIELD_CONNECTION, KEEP_ALIVE))
+        keepAlive = true;
     client->setKeepAlive(keepAlive);
 }
 
 void ServerManager::drainBodyAndSendError(Client* client, const RouteResult& res) {
-    bool   hasBody           = !client->getRequest().getHeader(HEADER_CONTENT_LENGTH).empty() && client->getContentLength() > 0;
+    bool   hasBody           = client->getRequest().hasHeader(FIELD_CONTENT_LENGTH) && client->getContentLength() > 0;
     bool   isChunkedReq      = client->isChunkedEncoding();
     bool   shouldClose       = false;
     size_t bodyBytesToRemove = 0;
@@ -356,7 +526,8 @@ void ServerManager::drainBodyAndSendError(Client* client, const RouteResult& res
         else
             shouldClose = true;
     } else if (isChunkedReq) {
-        size_t chunkedEnd = findChunkedBodyEnd(client->getStoreReceiveData());
+        const ReceiveBuffer& buffer     = client->getStoreReceiveData();
+        size_t               chunkedEnd = findChunkedBodyEnd(buffer.data(), buffer.size());
         if (chunkedEnd != String::npos)
             bodyBytesToRemove = chunkedEnd;
         else
@@ -364,7 +535,7 @@ void ServerManager::drainBodyAndSendError(Client* client, const RouteResult& res
     }
 
     sendErrorResponse(client, res.getStatusCode(), res.getErrorMessage().empty() ? getHttpStatusMessage(res.getStatusCode()) : res.getErrorMessage(),
-                      shouldClose, bodyBytesToRemove);
+                      shouldClose, bodyBytesToRemove, &res);
 }
 
 bool ServerManager::validateRequestBody(Client* client, const RouteResult& res, bool hasContentLength, bool isChunked) {
@@ -403,11 +574,15 @@ void ServerManager::handleCgiBodyStreaming(Client* client) {
     ssize_t     maxBody   = getMaxBodySize(boundRes);
     CgiProcess& cgi       = client->getCgi();
 
+    // the body is complete; anything still buffered is the next request
+    if (cgi.isWriteDone())
+        return;
     if (isChunked) {
-        String decoded;
-        bool   chunkedDone = false;
-        size_t consumed    = 0;
-        if (!decodeChunkedIncremental(client->getStoreReceiveData(), decoded, chunkedDone, consumed))
+        const ReceiveBuffer& buffer = client->getStoreReceiveData();
+        String               decoded;
+        bool                 chunkedDone = false;
+        size_t               consumed    = 0;
+        if (!decodeChunkedIncremental(buffer.data(), buffer.size(), decoded, chunkedDone, consumed))
             return sendErrorResponse(client, HTTP_BAD_REQUEST, getHttpStatusMessage(HTTP_BAD_REQUEST), true, 0);
         if (consumed > 0)
             client->removeReceivedData(consumed);
@@ -432,7 +607,7 @@ void ServerManager::handleCgiBodyStreaming(Client* client) {
         if (available > 0) {
             if (maxBody >= 0 && (ssize_t)(totalReceived + available) > maxBody)
                 return sendErrorResponse(client, HTTP_PAYLOAD_TOO_LARGE, getHttpStatusMessage(HTTP_PAYLOAD_TOO_LARGE), true, 0);
-            cgi.appendBuffer(client->getStoreReceiveData().c_str(), available);
+            cgi.appendBuffer(client->getStoreReceiveData().data(), available);
             client->removeReceivedData(available);
             if (cgi.getWriteFd() != INVALID_FD)
                 pollManager.addFd(cgi.getWriteFd(), POLLOUT);
@@ -464,15 +639,20 @@ bool ServerManager::handleRegularBody(Client* client) {
                 return true;
             }
         } else {
+            if (serveFromContentCache(client, res, cl))
+                return true;
             HttpResponse response = responseBuilder.build(res, &client->getCgi(), getServerFds());
             finalizeResponse(client, response, cl);
             return true;
         }
     } else if (isChunked) {
         String decoded;
-        if (decodeChunkedBody(client->getStoreReceiveData(), decoded)) {
+        const ReceiveBuffer& buffer = client->getStoreReceiveData();
+        if (decodeChunkedBody(buffer.data(), buffer.size(), decoded)) {
             RouteResult res     = getValue(clientRoutes, client->getFd(), RouteResult());
             ssize_t     maxBody = getMaxBodySize(res);
+            // pipelined requests may follow the terminating chunk
+            size_t bodyLen = findChunkedBodyEnd(buffer.data(), buffer.size());
 
             if (maxBody >= 0 && decoded.size() > (size_t)maxBody) {
                 sendErrorResponse(client, HTTP_PAYLOAD_TOO_LARGE, getHttpStatusMessage(HTTP_PAYLOAD_TOO_LARGE), true, 0);
@@ -485,15 +665,15 @@ bool ServerManager::handleRegularBody(Client* client) {
             if (res.getHandlerType() == CGI) {
                 client->getCgi().appendBuffer(decoded.c_str(), decoded.size());
                 client->getCgi().setWriteDone(true);
+                client->removeReceivedData(bodyLen);
                 responseBuilder.build(res, &client->getCgi(), getServerFds());
                 if (client->getCgi().isActive()) {
                     registerCgiPipes(client);
                     return true;
                 }
             } else {
-                client->clearStoreReceiveData();
                 HttpResponse response = responseBuilder.build(res, &client->getCgi(), getServerFds());
-                finalizeResponse(client, response, 0);
+                finalizeResponse(client, response, bodyLen);
                 return true;
             }
         }
@@ -502,27 +682,23 @@ bool ServerManager::handleRegularBody(Client* client) {
 }
 
 void ServerManager::closeClientConnection(int clientFd) {
-    Client* c = getValue(clients, clientFd, (Client*)NULL);
+    Client* c = fdTable.getClient(clientFd);
     if (c) {
         Logger::info("Closing connection for client " + typeToString(clientFd));
         if (c->getCgi().isActive())
             cleanupClientCgi(c);
     }
     pollManager.removeFdByValue(clientFd);
-    if (c) {
-        c->closeConnection();
-        delete c;
-    }
-    clients.erase(clientFd);
-    clientToServer.erase(clientFd);
+    timers.cancel(clientFd);
+    if (c)
+        clientPool.release(c);
+    fdTable.clear(clientFd);
     clientRoutes.erase(clientFd);
 }
 
-bool ServerManager::isCgiPipe(int fd) const { return cgiPipeToClient.count(fd); }
-
 void ServerManager::removeCgiPipe(int pipeFd) {
     pollManager.removeFdByValue(pipeFd);
-    cgiPipeToClient.erase(pipeFd);
+    fdTable.clear(pipeFd);
 }
 
 void ServerManager::registerCgiPipes(Client* client) {
@@ -531,14 +707,15 @@ void ServerManager::registerCgiPipes(Client* client) {
         cgi.closeWriteFd();
     } else {
         pollManager.addFd(cgi.getWriteFd(), POLLOUT);
-        cgiPipeToClient[cgi.getWriteFd()] = client->getFd();
+        fdTable.setCgiPipe(cgi.getWriteFd(), FD_CGI_STDIN, client);
     }
     pollManager.addFd(cgi.getReadFd(), POLLIN);
-    cgiPipeToClient[cgi.getReadFd()] = client->getFd();
+    fdTable.setCgiPipe(cgi.getReadFd(), FD_CGI_STDOUT, client);
+    timers.schedule(client->getFd(), clientDeadline(client));
 }
 
 void ServerManager::handleCgiWrite(int pipeFd) {
-    Client* client = getValue(clients, getValue(cgiPipeToClient, pipeFd, INVALID_FD), (Client*)NULL);
+    Client* client = fdTable.get(pipeFd).client;
     if (!client)
         return removeCgiPipe(pipeFd);
     CgiProcess& cgi = client->getCgi();
@@ -554,7 +731,7 @@ void ServerManager::handleCgiWrite(int pipeFd) {
 }
 
 void ServerManager::handleCgiRead(int pipeFd) {
-    Client* client = getValue(clients, getValue(cgiPipeToClient, pipeFd, INVALID_FD), (Client*)NULL);
+    Client* client = fdTable.get(pipeFd).client;
     if (!client)
         return removeCgiPipe(pipeFd);
     if (client->getCgi().handleRead())
@@ -564,12 +741,13 @@ void ServerManager::handleCgiRead(int pipeFd) {
     cgi.closeWriteFd();
     cgi.closeReadFd();
     cgi.finish();
-    HttpResponse cgiResponse = responseBuilder.buildCgiResponse(cgi);
+    HttpResponse cgiResponse = responseBuilder.buildCgiResponse(cgi, getValue(clientRoutes, client->getFd(), RouteResult()));
     cgiResponse.addHeader("Connection", client->isKeepAlive() ? "keep-alive" : "close");
-    client->setSendData(cgiResponse.toString());
+    client->queueResponse(cgiResponse, httpDate);
     client->resetForNextRequest();
     clientRoutes.erase(client->getFd());
     pollManager.addFd(client->getFd(), POLLIN | POLLOUT);
+    resumePipeline(client);
 }
 
 void ServerManager::cleanupClientCgi(Client* client) {
@@ -580,27 +758,23 @@ void ServerManager::cleanupClientCgi(Client* client) {
     client->getCgi().cleanup();
 }
 
-Server* ServerManager::findServerByFd(int serverFd) const {
-    MapIntServerPtr::const_iterator it = serverFdMap.find(serverFd);
-    return it != serverFdMap.end() ? it->second : NULL;
-}
-
-bool ServerManager::isServerSocket(int fd) const { return findServerByFd(fd) != NULL; }
-
 void ServerManager::shutdown() {
-    for (MapIntClientPtr::iterator it = clients.begin(); it != clients.end(); ++it) {
-        if (it->second->getCgi().isActive())
-            cleanupClientCgi(it->second);
-        delete it->second;
+    for (size_t fd = 0; fd < fdTable.capacity(); fd++) {
+        Client* client = fdTable.getClient(fd);
+        if (!client)
+            continue;
+        if (client->getCgi().isActive())
+            cleanupClientCgi(client);
+        clientPool.release(client);
+        fdTable.clear(fd);
     }
-    clients.clear();
     for (size_t i = 0; i < servers.size(); i++)
         delete servers[i];
     servers.clear();
 }
 
 size_t ServerManager::getServerCount() const { return servers.size(); }
-size_t ServerManager::getClientCount() const { return clients.size(); }
+size_t ServerManager::getClientCount() const { return clientPool.inUse(); }
 
 VectorInt ServerManager::getServerFds() const {
     VectorInt fds;
@@ -7,18 +7,25 @@
 #include <iostream>
 #include <map>
 #include <vector>
+#include "../config/HttpConfig.hpp"
 #include "../config/MimeTypes.hpp"
 #include "../config/ServerConfig.hpp"
+#include "../http/ContentCache.hpp"
+#include "../http/ErrorPageCache.hpp"
 #include "../http/HttpRequest.hpp"
 #include "../http/HttpResponse.hpp"
 #include "../http/ResponseBuilder.hpp"
 #include "../http/Router.hpp"
 #include "../utils/Logger.hpp"
+#include "../utils/OpenFileCache.hpp"
 #include "../utils/SessionManager.hpp"
 #include "../utils/Utils.hpp"
 #include "Client.hpp"
+#include "ClientPool.hpp"
+#include "FdTable.hpp"
 #include "PollManager.hpp"
 #include "Server.hpp"
+#include "TimerWheel.hpp"
 
 extern volatile sig_atomic_t g_running;
 
@@ -26,11 +33,14 @@ class ServerManager {
    public:
     ServerManager();
     ServerManager(const VectorServerConfig& configs);
+    ServerManager(const VectorServerConfig& configs, const HttpConfig& httpConfig);
+    ServerManager(const VectorServerConfig& configs, const HttpConfig& httpConfig, SessionManager& sharedSessions);
     ~ServerManager();
 
     bool   initialize();
     bool   run();
     void   shutdown();
+    void   watchWakeupFd(int fd);
     size_t getServerCount() const;
     size_t getClientCount() const;
 
@@ -40,37 +50,49 @@ class ServerManager {
     PollManager                pollManager;
     std::vector<Server*>       servers;
     const VectorServerConfig   serverConfigs;
-    MapIntClientPtr            clients;
-    MapIntServerPtr            clientToServer;
+    const HttpConfig           httpConfig;
+    FdTable                    fdTable;
+    ClientPool                 clientPool;
     MapIntVectorServerConfig   serverToConfigs;
-    MapIntServerPtr            serverFdMap;
     MimeTypes                  mimeTypes;
     ResponseBuilder            responseBuilder;
-    SessionManager             sessionManager;
-    MapInt                     cgiPipeToClient;
+    SessionManager             localSessions;
+    SessionManager&            sessionManager;
     std::map<int, RouteResult> clientRoutes;
+    TimerWheel                 timers;
+    HttpDate                   httpDate;
+    OpenFileCache              openFileCache;
+    ContentCache               contentCache;
+    ErrorPageCache             errorPages;
+    time_t                     nextSessionCleanup;
 
     // Internal helpers
     bool    initializeServers(const VectorServerConfig& serversConfigs);
+    void    configureCaches();
     bool    acceptNewConnection(Server* server);
     void    handleClientRead(int clientFd);
     void    handleClientWrite(int clientFd);
-    void    checkTimeouts(int timeout);
+    void    processTimers(time_t now);
+    time_t  clientDeadline(Client* client) const;
+    int     computePollTimeout(time_t now) const;
     void    closeClientConnection(int clientFd);
-    Server* findServerByFd(int serverFd) const;
-    bool    isServerSocket(int fd) const;
-    bool    isCgiPipe(int fd) const;
+    void    dispatchEvent(int fd, bool hasIn, bool hasOut, bool hasErr);
     void    processRequest(Client* client, Server* server);
+    void    resumePipeline(Client* client);
     bool    parseAndRouteHeaders(Client* client, Server* server);
     void    parseConnectionHeader(Client* client);
     void    drainBodyAndSendError(Client* client, const RouteResult& res);
     bool    validateRequestBody(Client* client, const RouteResult& res, bool hasContentLength, bool isChunked);
     void    handleCgiBodyStreaming(Client* client);
     bool    handleRegularBody(Client* client);
-    void    finalizeResponse(Client* client, const HttpResponse& response, ssize_t bodyLen);
+    void    finalizeResponse(Client* client, HttpResponse& response, ssize_t bodyLen);
+    bool    serveFromContentCache(Client* client, const RouteResult& res, ssize_t bodyLen);
+    void    completeRequest(Client* client, ssize_t bodyLen);
     ssize_t getMaxBodySize(const RouteResult& res) const;
     Server* initializeServer(const ServerConfig& serverConfig, size_t listenIndex);
-    void    sendErrorResponse(Client* client, int statusCode, const String& message, bool closeConnection, size_t bytesToRemove);
+    bool    queueCachedError(Client* client, int statusCode, const String& message, const RouteResult* route);
+    void    sendErrorResponse(Client* client, int statusCode, const String& message, bool closeConnection, size_t bytesToRemove,
+                              const RouteResult* route = NULL);
     // CGI pipe helpers
     void registerCgiPipes(Client* client);
     void handleCgiRead(int pipeFd);
@@ -0,0 +1,137 @@
+#include "TimerWheel.hpp"
+
+TimerWheel::TimerWheel() : current(getCurrentTime()), armed() {}
+
+TimerWheel::TimerWheel(time_t now) : current(now), armed() {}
+
+TimerWheel::TimerWheel(const TimerWheel& other) : current(other.current), armed(other.armed) {
+    for (size_t i = 0; i < TIMER_WHEEL_SLOTS; i++) {
+        nearSlots[i] = other.nearSlots[i];
+        farSlots[i]  = other.farSlots[i];
+    }
+}
+
+TimerWheel& TimerWheel::operator=(const TimerWheel& other) {
+    if (this != &other) {
+        for (size_t i = 0; i < TIMER_WHEEL_SLOTS; i++) {
+            nearSlots[i] = other.nearSlots[i];
+            farSlots[i]  = other.farSlots[i];
+        }
+        current = other.current;
+        armed   = other.armed;
+    }
+    return *this;
+}
+
+TimerWheel::~TimerWheel() {}
+
+void TimerWheel::schedule(int id, time_t deadline) {
+    std::map<int, time_t>::iterator it = armed.find(id);
+    if (it != armed.end() && it->second == deadline)
+        return;
+    armed[id] = deadline;
+    TimerEntry entry;
+    entry.id       = id;
+    entry.deadline = deadline;
+    insert(entry);
+}
+
+void TimerWheel::cancel(int id) {
+    armed.erase(id);
+}
+
+// Expired ids are disarmed before being returned, so the caller may
+// schedule() them again right away.
+void TimerWheel::advance(time_t now, VectorInt& expired) {
+    if (now - current >= static_cast<time_t>(TIMER_WHEEL_SLOTS * TIMER_WHEEL_SLOTS)) {
+        rebase(now, expired);
+        return;
+    }
+    while (current <= now) {
+        if (current % TIMER_WHEEL_SLOTS == 0)
+            cascade(current / TIMER_WHEEL_SLOTS);
+        TimerSlot slot;
+        slot.swap(nearSlots[current % TIMER_WHEEL_SLOTS]);
+        for (size_t i = 0; i < slot.size(); i++) {
+            if (!isLive(slot[i]))
+                continue;
+            if (slot[i].deadline > now) {
+                insert(slot[i]);
+                continue;
+            }
+            armed.erase(slot[i].id);
+            expired.push_back(slot[i].id);
+        }
+        current++;
+    }
+}
+
+// Never later than the earliest live deadline; superseded entries may make
+// the loop wake early. Returns 0 when nothing is armed.
+time_t TimerWheel::nextDeadline() const {
+    if (armed.empty())
+        return 0;
+    for (time_t t = current; t < current + TIMER_WHEEL_SLOTS; t++)
+        if (!nearSlots[t % TIMER_WHEEL_SLOTS].empty())
+            return t;
+    time_t block = current / TIMER_WHEEL_SLOTS + 1;
+    for (time_t b = block; b < block + TIMER_WHEEL_SLOTS; b++)
+        if (!farSlots[b % TIMER_WHEEL_SLOTS].empty())
+            return b * TIMER_WHEEL_SLOTS;
+    return current;
+}
+
+size_t TimerWheel::size() const {
+    return armed.size();
+}
+
+void TimerWheel::insert(const TimerEntry& entry) {
+    TimerEntry e = entry;
+    if (e.deadline < current)
+        e.deadline = current;
+    if (e.deadline - current < static_cast<time_t>(TIMER_WHEEL_SLOTS)) {
+        nearSlots[e.deadline % TIMER_WHEEL_SLOTS].push_back(entry);
+        return;
+    }
+    time_t block    = e.deadline / TIMER_WHEEL_SLOTS;
+    time_t maxBlock = current / TIMER_WHEEL_SLOTS + TIMER_WHEEL_SLOTS - 1;
+    if (block > maxBlock)
+        block = maxBlock;
+    farSlots[block % TIMER_WHEEL_SLOTS].push_back(entry);
+}
+
+void TimerWheel::cascade(time_t block) {
+    TimerSlot slot;
+    slot.swap(farSlots[block % TIMER_WHEEL_SLOTS]);
+    for (size_t i = 0; i < slot.size(); i++)
+        if (isLive(slot[i]))
+            insert(slot[i]);
+}
+
+// Used after a long stall or a clock jump, where ticking every second
+// would be wasteful: expire what is due and re-file the rest.
+void TimerWheel::rebase(time_t now, VectorInt& expired) {
+    for (size_t i = 0; i < TIMER_WHEEL_SLOTS; i++) {
+        nearSlots[i].clear();
+        farSlots[i].clear();
+    }
+    current = now + 1;
+    std::map<int, time_t>::iterator it = armed.begin();
+    while (it != armed.end()) {
+        if (it->second <= now) {
+            expired.push_back(it->first);
+            armed.erase(it++);
+            continue;
+        }
+        TimerEntry entry;
+        entry.id       = it->first;
+        entry.deadline = it->second;
+        insert(entry);
+        ++it;
+    }
+}
+
+bool TimerWheel::isLive(const TimerEntry& entry) const {
+    std::map<int, time_t>::const_iterator it = armed.find(entry.id);
+    return it != armed.end() && it->second == entry.deadline;
+}
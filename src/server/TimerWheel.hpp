@@ -0,0 +1,51 @@
+#ifndef TIMER_WHEEL_HPP
+#define TIMER_WHEEL_HPP
+
+#include <ctime>
+#include <map>
+#include <vector>
+#include "../utils/Utils.hpp"
+
+struct TimerEntry {
+    int    id;
+    time_t deadline;
+};
+
+typedef std::vector<TimerEntry> TimerSlot;
+
+// Two-level hashed timing wheel with one-second ticks. The near level holds
+// the next TIMER_WHEEL_SLOTS seconds; the far level holds blocks of
+// TIMER_WHEEL_SLOTS seconds and is cascaded into the near level as time
+// advances. Deadlines beyond the far level are parked in its last block and
+// re-cascaded.
+//
+// Each id has at most one live deadline: schedule() replaces it and cancel()
+// drops it. Superseded entries stay in their slot and are discarded when
+// reached, so both calls are O(log n) and never walk a slot.
+class TimerWheel {
+   public:
+    TimerWheel();
+    explicit TimerWheel(time_t now);
+    TimerWheel(const TimerWheel& other);
+    TimerWheel& operator=(const TimerWheel& other);
+    ~TimerWheel();
+
+    void   schedule(int id, time_t deadline);
+    void   cancel(int id);
+    void   advance(time_t now, VectorInt& expired);
+    time_t nextDeadline() const;
+    size_t size() const;
+
+   private:
+    TimerSlot             nearSlots[TIMER_WHEEL_SLOTS];
+    TimerSlot             farSlots[TIMER_WHEEL_SLOTS];
+    time_t                current; // next second to be processed
+    std::map<int, time_t> armed;   // id -> live deadline
+
+    void insert(const TimerEntry& entry);
+    void cascade(time_t block);
+    void rebase(time_t now, VectorInt& expired);
+    bool isLive(const TimerEntry& entry) const;
+};
+
+#endif
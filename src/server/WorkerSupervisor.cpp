@@ -0,0 +1,168 @@
+#include "WorkerSupervisor.hpp"
+#include <sched.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+
+static void masterSignalHandler(int signum) {
+    (void)signum;
+    g_running = 0;
+}
+
+// No SA_RESTART: a shutdown signal must interrupt the blocking waitpid().
+static void setupMasterSignals() {
+    struct sigaction sa;
+    std::memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = masterSignalHandler;
+    sigemptyset(&sa.sa_mask);
+    sa.sa_flags = 0;
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+    signal(SIGPIPE, SIG_IGN);
+    signal(SIGCHLD, SIG_DFL);
+}
+
+WorkerSupervisor::WorkerSupervisor(const VectorServerConfig& configs, const HttpConfig& _httpConfig, WorkerEntry _entry)
+    : serverConfigs(configs), httpConfig(_httpConfig), entry(_entry), workers(), startTimes() {}
+
+WorkerSupervisor::~WorkerSupervisor() {
+    stopWorkers();
+}
+
+bool WorkerSupervisor::run() {
+    size_t count = httpConfig.getWorkerProcesses();
+    setupMasterSignals();
+    g_running = 1;
+    workers.assign(count, -1);
+    startTimes.assign(count, 0);
+    for (size_t i = 0; i < count; i++) {
+        if (!spawnWorker(i)) {
+            stopWorkers();
+            return false;
+        }
+    }
+    Logger::info("Master process " + typeToString(getpid()) + " supervising " + typeToString(count) + " workers");
+
+    bool ok = true;
+    while (g_running) {
+        int   status = 0;
+        pid_t pid    = waitpid(-1, &status, 0);
+        if (pid < 0) {
+            if (errno == EINTR)
+                continue;
+            ok = Logger::error("waitpid failed in master process");
+            break;
+        }
+        ssize_t index = findWorker(pid);
+        if (index < 0)
+            continue;
+        workers[index] = -1;
+        logWorkerExit(index, pid, status);
+        if (!g_running)
+            break;
+        if (getElapsedSeconds(startTimes[index], getCurrentTime()) < WORKER_MIN_UPTIME) {
+            ok = Logger::error("Worker " + typeToString(index) + " exited during startup, shutting down");
+            break;
+        }
+        if (!spawnWorker(index)) {
+            ok = false;
+            break;
+        }
+    }
+    stopWorkers();
+    return ok;
+}
+
+bool WorkerSupervisor::spawnWorker(size_t index) {
+    pid_t pid = fork();
+    if (pid < 0)
+        return Logger::error("Failed to fork worker " + typeToString(index));
+    if (pid == 0)
+        runWorker(index);
+    workers[index]    = pid;
+    startTimes[index] = getCurrentTime();
+    return Logger::info("Worker " + typeToString(index) + " started with pid " + typeToString(pid));
+}
+
+// Never returns: the worker must not fall back into the master's stack.
+void WorkerSupervisor::runWorker(size_t index) {
+    int status = 1;
+    if (httpConfig.getWorkerCpuAffinity())
+        pinToCpu(index);
+    try {
+        status = entry(serverConfigs, httpConfig);
+    } catch (const std::exception& e) {
+        Logger::error("Worker " + typeToString(index) + " fatal error: " + String(e.what()));
+    } catch (...) {
+        Logger::error("Worker " + typeToString(index) + " fatal unknown error");
+    }
+    std::exit(status);
+}
+
+// Picks the index-th CPU of the inherited affinity mask so cpusets and
+// taskset restrictions on the master are respected.
+void WorkerSupervisor::pinToCpu(size_t index) const {
+#ifdef __linux__
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+        Logger::error("sched_getaffinity failed for worker " + typeToString(index));
+        return;
+    }
+    int available = CPU_COUNT(&allowed);
+    if (available <= 0)
+        return;
+    int target = static_cast<int>(index % available);
+    for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+        if (!CPU_ISSET(cpu, &allowed))
+            continue;
+        if (target-- > 0)
+            continue;
+        cpu_set_t pinned;
+        CPU_ZERO(&pinned);
+        CPU_SET(cpu, &pinned);
+        if (sched_setaffinity(0, sizeof(pinned), &pinned) != 0)
+            Logger::error("sched_setaffinity failed for worker " + typeToString(index));
+        else
+            Logger::info("Worker " + typeToString(index) + " pinned to CPU " + typeToString(cpu));
+        return;
+    }
+#else
+    (void)index;
+    Logger::error("worker_cpu_affinity is not supported on this platform");
+#endif
+}
+
+void WorkerSupervisor::logWorkerExit(size_t index, pid_t pid, int status) const {
+    String who = "Worker " + typeToString(index) + " (pid " + typeToString(pid) + ")";
+    if (WIFSIGNALED(status))
+        Logger::error(who + " killed by signal " + typeToString(WTERMSIG(status)));
+    else if (WIFEXITED(status) && WEXITSTATUS(status) != 0)
+        Logger::error(who + " exited with status " + typeToString(WEXITSTATUS(status)));
+    else
+        Logger::info(who + " exited");
+}
+
+void WorkerSupervisor::stopWorkers() {
+    for (size_t i = 0; i < workers.size(); i++)
+        if (workers[i] > 0)
+            kill(workers[i], SIGTERM);
+    for (size_t i = 0; i < workers.size(); i++) {
+        if (workers[i] <= 0)
+            continue;
+        int status = 0;
+        while (waitpid(workers[i], &status, 0) < 0 && errno == EINTR)
+            ;
+        logWorkerExit(i, workers[i], status);
+        workers[i] = -1;
+    }
+}
+
+ssize_t WorkerSupervisor::findWorker(pid_t pid) const {
+    for (size_t i = 0; i < workers.size(); i++)
+        if (workers[i] == pid)
+            return static_cast<ssize_t>(i);
+    return -1;
+}
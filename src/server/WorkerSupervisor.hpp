@@ -0,0 +1,46 @@
+#ifndef WORKER_SUPERVISOR_HPP
+#define WORKER_SUPERVISOR_HPP
+
+#include <signal.h>
+#include <sys/types.h>
+#include <vector>
+#include "../config/HttpConfig.hpp"
+#include "../config/ServerConfig.hpp"
+#include "../utils/Logger.hpp"
+#include "../utils/Utils.hpp"
+
+extern volatile sig_atomic_t g_running;
+
+// Entry point executed by every worker; returns the worker's exit status.
+typedef int (*WorkerEntry)(const VectorServerConfig& configs, const HttpConfig& httpConfig);
+
+// Master side of the worker_processes model. Each worker runs its own
+// ServerManager and binds its own listeners; SO_REUSEPORT lets the kernel
+// spread incoming connections across them. The master only forks, reaps,
+// respawns crashed workers and forwards shutdown.
+class WorkerSupervisor {
+   public:
+    WorkerSupervisor(const VectorServerConfig& configs, const HttpConfig& httpConfig, WorkerEntry entry);
+    ~WorkerSupervisor();
+
+    bool run();
+
+   private:
+    WorkerSupervisor(const WorkerSupervisor&);
+    WorkerSupervisor& operator=(const WorkerSupervisor&);
+
+    const VectorServerConfig serverConfigs;
+    const HttpConfig         httpConfig;
+    WorkerEntry              entry;
+    std::vector<pid_t>       workers;
+    std::vector<time_t>      startTimes;
+
+    bool    spawnWorker(size_t index);
+    void    runWorker(size_t index);
+    void    pinToCpu(size_t index) const;
+    void    logWorkerExit(size_t index, pid_t pid, int status) const;
+    void    stopWorkers();
+    ssize_t findWorker(pid_t pid) const;
+};
+
+#endif
@@ -0,0 +1,57 @@
+#include "ByteScan.hpp"
+#include <cstring>
+#include "Constants.hpp"
+
+// First `c` in [begin, end), or end when absent.
+const char* scanByte(const char* begin, const char* end, char c) {
+    const void* hit = std::memchr(begin, c, end - begin);
+    return hit ? static_cast<const char*>(hit) : end;
+}
+
+// First occurrence of needle[0, length) in [begin, end), or end when absent.
+const char* scanSequence(const char* begin, const char* end, const char* needle, size_t length) {
+    if (length == 0)
+        return begin;
+    if (static_cast<size_t>(end - begin) < length)
+        return end;
+    if (length == 1)
+        return scanByte(begin, end, needle[0]);
+    // candidates start before `last`
+    const char* last = end - length + 1;
+    for (const char* p = begin; p < last; ++p) {
+        p = static_cast<const char*>(std::memchr(p, needle[0], last - p));
+        if (!p)
+            break;
+        if (p[length - 1] == needle[length - 1] && std::memcmp(p + 1, needle + 1, length - 2) == 0)
+            return p;
+    }
+    return end;
+}
+
+// String::find() equivalents.
+size_t findByte(const String& s, char c, size_t from) {
+    if (from >= s.size())
+        return String::npos;
+    const char* end = s.data() + s.size();
+    const char* hit = scanByte(s.data() + from, end, c);
+    return hit == end ? String::npos : static_cast<size_t>(hit - s.data());
+}
+
+size_t findSequence(const String& s, const String& needle, size_t from) {
+    if (from > s.size())
+        return String::npos;
+    const char* end = s.data() + s.size();
+    const char* hit = scanSequence(s.data() + from, end, needle.data(), needle.size());
+    if (hit == end && !needle.empty())
+        return String::npos;
+    return static_cast<size_t>(hit - s.data());
+}
+
+size_t findCrlf(const String& s, size_t from) { return findCrlf(s.data(), s.size(), from); }
+
+size_t findCrlf(const char* data, size_t size, size_t from) {
+    if (from > size)
+        return String::npos;
+    const char* hit = scanSequence(data + from, data + size, CRLF, 2);
+    return hit == data + size ? String::npos : static_cast<size_t>(hit - data);
+}
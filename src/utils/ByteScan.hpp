@@ -0,0 +1,20 @@
+#ifndef BYTE_SCAN_HPP
+#define BYTE_SCAN_HPP
+
+#include <cstddef>
+#include "Types.hpp"
+
+// Delimiter search for the request parser, the chunked decoder and the
+// multipart splitter. Every search is built on memchr(), which libc ships
+// optimized and vectorized for the running CPU; a sequence search jumps
+// between occurrences of its first byte and checks the last byte before
+// comparing the rest.
+const char* scanByte(const char* begin, const char* end, char c);
+const char* scanSequence(const char* begin, const char* end, const char* needle, size_t length);
+
+size_t findByte(const String& s, char c, size_t from = 0);
+size_t findSequence(const String& s, const String& needle, size_t from = 0);
+size_t findCrlf(const String& s, size_t from = 0);
+size_t findCrlf(const char* data, size_t size, size_t from);
+
+#endif
@@ -8,9 +8,12 @@
 // ! HTTP STATUS CODES - 2xx Success
 #define HTTP_OK 200
 #define HTTP_CREATED 201
+#define HTTP_NO_CONTENT 204
+#define HTTP_PARTIAL_CONTENT 206
 
 // ! HTTP STATUS CODES - 3xx Redirect
 #define HTTP_MOVED_PERMANENTLY 301
+#define HTTP_NOT_MODIFIED 304
 
 // ! HTTP STATUS CODES - 4xx Client Error
 #define HTTP_BAD_REQUEST 400
@@ -20,6 +23,7 @@
 #define HTTP_LENGTH_REQUIRED 411
 #define HTTP_PAYLOAD_TOO_LARGE 413
 #define HTTP_URI_TOO_LONG 414
+#define HTTP_RANGE_NOT_SATISFIABLE 416
 #define HTTP_REQUEST_HEADER_FIELDS_TOO_LARGE 431
 
 // ! HTTP STATUS CODES - 5xx Server Error
@@ -32,12 +36,27 @@
 #define HEADER_CONTENT_TYPE "Content-Type"
 #define HEADER_CONTENT_LENGTH "Content-Length"
 #define HEADER_CONTENT_DISPOSITION "Content-Disposition"
+#define HEADER_TRANSFER_ENCODING "Transfer-Encoding"
+#define HEADER_CONTENT_ENCODING "Content-Encoding"
+#define HEADER_ACCEPT_ENCODING "Accept-Encoding"
+#define HEADER_VARY "Vary"
+#define HEADER_ETAG "ETag"
+#define HEADER_LAST_MODIFIED "Last-Modified"
+#define HEADER_IF_NONE_MATCH "If-None-Match"
+#define HEADER_IF_MODIFIED_SINCE "If-Modified-Since"
+#define HEADER_RANGE "Range"
+#define HEADER_IF_RANGE "If-Range"
+#define HEADER_ACCEPT_RANGES "Accept-Ranges"
+#define HEADER_CONTENT_RANGE "Content-Range"
+#define HEADER_EXPIRES "Expires"
+#define HEADER_CACHE_CONTROL "Cache-Control"
 #define HEADER_HOST "host"
 #define HEADER_COOKIE "cookie"
 #define HEADER_SET_COOKIE "Set-Cookie"
 #define HEADER_CONNECTION "Connection"
 #define HEADER_DATE "Date"
 #define HEADER_SERVER "Server"
+#define SERVER_SOFTWARE "Webserv/1.0"
 #define CLOSE "close"
 #define KEEP_ALIVE "keep-alive"
 
@@ -61,6 +80,7 @@
 #define COLON ':'
 #define SEMICOLON ';'
 #define EQUALS '='
+#define AMPERSAND '&'
 #define HASH '#'
 #define QUESTION '?'
 #define DOT '.'
@@ -69,6 +89,7 @@
 // ! MAX LIMITS
 #define MAX_URI_LENGTH (8 * KB)
 #define MAX_HEADER_SIZE (8 * KB)
+#define MAX_BYTE_RANGES 16
 #define BUFFER_SIZE (64 * KB)
 #ifndef SIZE_MAX
 #define SIZE_MAX (18446744073709551615UL)
@@ -76,14 +97,43 @@
 
 // ! CONNECTION LIMITS
 #define MAX_CONNECTIONS 1024
+#define MAX_WORKER_CONNECTIONS 65536
+#define CLIENT_BUFFER_RETAIN (2 * BUFFER_SIZE)
+#define SEND_CHUNK_SIZE (256 * KB)
+#define SEND_IOV_MAX 64
+
+// ! FILE CACHES
+#define MAX_OPEN_FILE_CACHE 65536
+#define OPEN_FILE_CACHE_INACTIVE 60
+#define OPEN_FILE_CACHE_VALID 60
+#define CONTENT_CACHE_MAX_FILE (64 * KB)
+#define GZIP_DEFAULT_LEVEL 1
+#define GZIP_MIN_LENGTH 20
+#define GZIP_CHUNK_SIZE (16 * KB)
+#define EXPIRES_OFF -1
+#define EXPIRES_EPOCH -2
+#define EXPIRES_MAX (10 * 365L * SECONDS_PER_DAY)
+#define EPOLL_MAX_EVENTS 1024
+#define DEFAULT_ACCEPT_BUDGET 64
+#define DEFAULT_PIPELINE_DEPTH 16
+#define MAX_PIPELINE_DEPTH 256
+
+// ! WORKER PROCESSES
+#define MAX_WORKER_PROCESSES 64
+#define WORKER_MIN_UPTIME 2
+#define MAX_WORKER_THREADS 64
 
 // ! TIMEOUTS
 #define CLIENT_TIMEOUT 60
 #define CGI_TIMEOUT 60
-#define POLL_TIMEOUT_MS 100
+#define MAX_POLL_TIMEOUT_MS (60 * 1000)
+#define TIMER_WHEEL_SLOTS 64
 #define SECONDS_PER_DAY 86400
 #define SECONDS_PER_HOUR 3600
 #define SECONDS_PER_MIN 60
+#define HTTP_DATE_LENGTH 29
+#define MAX_CONFIG_SECONDS (365L * SECONDS_PER_DAY)
+#define MAX_CONFIG_BYTES (1024L * MB)
 
 // ! DEFAULTS
 #define MAX_PORT 65535
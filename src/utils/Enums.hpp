@@ -3,5 +3,22 @@
 enum Type { TOKEN_WORD, TOKEN_STRING, TOKEN_SEMICOLON, TOKEN_LBRACE, TOKEN_RBRACE, TOKEN_EOF };
 enum FileType { SINGLEFILE, DIRECTORY, UNKNOWN };
 enum HandlerType { STATIC, DIRECTORY_LISTING, CGI, UPLOAD, NOT_FOUND, DELETE_FILE };
+enum EventBackendType { BACKEND_POLL, BACKEND_EPOLL };
+enum FdRole { FD_NONE, FD_LISTENER, FD_CLIENT, FD_CGI_STDIN, FD_CGI_STDOUT };
+enum HeaderId {
+    FIELD_HOST,
+    FIELD_CONNECTION,
+    FIELD_CONTENT_LENGTH,
+    FIELD_CONTENT_TYPE,
+    FIELD_TRANSFER_ENCODING,
+    FIELD_COOKIE,
+    FIELD_ACCEPT_ENCODING,
+    FIELD_IF_NONE_MATCH,
+    FIELD_IF_MODIFIED_SINCE,
+    FIELD_IF_RANGE,
+    FIELD_RANGE,
+    FIELD_CONTENT_DISPOSITION,
+    FIELD_UNKNOWN // also the number of well-known fields
+};
 
 #endif
\ No newline at end of file
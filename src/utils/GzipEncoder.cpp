@@ -0,0 +1,273 @@
+#include "GzipEncoder.hpp"
+
+#define WINDOW_SIZE 32768U
+#define WINDOW_MASK (WINDOW_SIZE - 1)
+#define HASH_BITS 15
+#define HASH_SIZE (1U << HASH_BITS)
+#define MIN_MATCH 3
+#define MAX_MATCH 258
+#define NO_POSITION 0xFFFFFFFFU
+#define STORED_OVERHEAD 5
+
+static const unsigned short LENGTH_BASE[29]  = {3,  4,  5,  6,  7,  8,  9,  10, 11,  13,  15,  17,  19,  23, 27,
+                                                31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+static const unsigned char  LENGTH_EXTRA[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+static const unsigned short DIST_BASE[30]    = {1,    2,    3,    4,    5,    7,     9,     13,    17,    25,
+                                                33,   49,   65,   97,   129,  193,   257,   385,   513,   769,
+                                                1025, 1537, 2049, 3073, 4097, 6145,  8193,  12289, 16385, 24577};
+static const unsigned char  DIST_EXTRA[30]   = {0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+static const int            MAX_CHAIN[10]    = {1, 4, 8, 16, 32, 64, 128, 256, 1024, 4096};
+
+struct CrcTable {
+    unsigned long entries[256];
+    CrcTable() {
+        for (unsigned long n = 0; n < 256; ++n) {
+            unsigned long c = n;
+            for (int k = 0; k < 8; ++k)
+                c = (c & 1) ? 0xEDB88320UL ^ (c >> 1) : c >> 1;
+            entries[n] = c;
+        }
+    }
+};
+
+static const CrcTable& crcTable() {
+    static const CrcTable table;
+    return table;
+}
+
+// Huffman codes are defined MSB-first but deflate packs bits LSB-first.
+static unsigned int reverseBits(unsigned int code, int length) {
+    unsigned int result = 0;
+    for (int i = 0; i < length; ++i) {
+        result = (result << 1) | (code & 1);
+        code >>= 1;
+    }
+    return result;
+}
+
+static unsigned int hash3(const char* p) {
+    unsigned int a = static_cast<unsigned char>(p[0]);
+    unsigned int b = static_cast<unsigned char>(p[1]);
+    unsigned int c = static_cast<unsigned char>(p[2]);
+    return ((a << 10) ^ (b << 5) ^ c) & (HASH_SIZE - 1);
+}
+
+GzipEncoder::GzipEncoder(int level)
+    : maxChain(MAX_CHAIN[level < 1 ? 1 : (level > 9 ? 9 : level)]),
+      headerSent(false),
+      crc(0xFFFFFFFFUL),
+      totalIn(0),
+      bitBuffer(0),
+      bitCount(0),
+      window(),
+      windowBase(0),
+      head(HASH_SIZE, NO_POSITION),
+      prev(WINDOW_SIZE, NO_POSITION) {}
+
+GzipEncoder::GzipEncoder(const GzipEncoder& other)
+    : maxChain(other.maxChain),
+      headerSent(other.headerSent),
+      crc(other.crc),
+      totalIn(other.totalIn),
+      bitBuffer(other.bitBuffer),
+      bitCount(other.bitCount),
+      window(other.window),
+      windowBase(other.windowBase),
+      head(other.head),
+      prev(other.prev) {}
+
+GzipEncoder& GzipEncoder::operator=(const GzipEncoder& other) {
+    if (this != &other) {
+        maxChain   = other.maxChain;
+        headerSent = other.headerSent;
+        crc        = other.crc;
+        totalIn    = other.totalIn;
+        bitBuffer  = other.bitBuffer;
+        bitCount   = other.bitCount;
+        window     = other.window;
+        windowBase = other.windowBase;
+        head       = other.head;
+        prev       = other.prev;
+    }
+    return *this;
+}
+
+GzipEncoder::~GzipEncoder() {}
+
+// ID1 ID2, CM=deflate, no flags, no mtime, no extra flags, OS=unix.
+void GzipEncoder::writeHeader(String& out) {
+    static const char header[10] = {'\x1f', '\x8b', 8, 0, 0, 0, 0, 0, 0, 3};
+    out.append(header, sizeof(header));
+    headerSent = true;
+}
+
+void GzipEncoder::putBits(unsigned int value, int count, String& out) {
+    bitBuffer |= static_cast<unsigned long>(value) << bitCount;
+    bitCount += count;
+    while (bitCount >= 8) {
+        out += static_cast<char>(bitBuffer & 0xFF);
+        bitBuffer >>= 8;
+        bitCount -= 8;
+    }
+}
+
+// Fixed Huffman literal codes: 0-143 use 8 bits from 0x30, 144-255 use 9
+// bits from 0x190.
+void GzipEncoder::putLiteral(unsigned char c, String& out) {
+    if (c < 144)
+        putBits(reverseBits(0x30 + c, 8), 8, out);
+    else
+        putBits(reverseBits(0x190 + c - 144, 9), 9, out);
+}
+
+// Length symbols 257-279 use 7 bits from 0, 280-287 use 8 bits from 0xC0;
+// distance symbols are plain 5-bit codes. Extra bits follow each symbol.
+void GzipEncoder::putMatch(size_t length, size_t distance, String& out) {
+    int code = 28;
+    while (LENGTH_BASE[code] > length)
+        --code;
+    int symbol = 257 + code;
+    if (symbol < 280)
+        putBits(reverseBits(symbol - 256, 7), 7, out);
+    else
+        putBits(reverseBits(0xC0 + symbol - 280, 8), 8, out);
+    if (LENGTH_EXTRA[code])
+        putBits(length - LENGTH_BASE[code], LENGTH_EXTRA[code], out);
+
+    code = 29;
+    while (DIST_BASE[code] > distance)
+        --code;
+    putBits(reverseBits(code, 5), 5, out);
+    if (DIST_EXTRA[code])
+        putBits(distance - DIST_BASE[code], DIST_EXTRA[code], out);
+}
+
+void GzipEncoder::insertHash(size_t pos) {
+    if (pos + MIN_MATCH > window.size())
+        return;
+    unsigned int h      = hash3(&window[pos]);
+    unsigned int offset = windowBase + static_cast<unsigned int>(pos);
+    prev[offset & WINDOW_MASK] = head[h];
+    head[h]                    = offset;
+}
+
+// Longest earlier match for window[pos..], walking at most maxChain
+// candidates. Offsets are 32-bit stream positions, so stale chain entries
+// show up as distances outside the window and end the walk.
+size_t GzipEncoder::findMatch(size_t pos, size_t& distance) const {
+    size_t limit = window.size() - pos;
+    if (limit > MAX_MATCH)
+        limit = MAX_MATCH;
+    const char*  cur      = &window[pos];
+    unsigned int offset   = windowBase + static_cast<unsigned int>(pos);
+    unsigned int cand     = head[hash3(cur)];
+    unsigned int lastDist = 0;
+    size_t       best     = 0;
+    for (int chain = maxChain; chain > 0 && cand != NO_POSITION; --chain) {
+        unsigned int dist = offset - cand;
+        if (dist <= lastDist || dist > WINDOW_SIZE || dist > pos)
+            break;
+        lastDist         = dist;
+        const char* from = cur - dist;
+        if (from[best] == cur[best]) {
+            size_t n = 0;
+            while (n < limit && from[n] == cur[n])
+                ++n;
+            if (n > best) {
+                best     = n;
+                distance = dist;
+                if (n == limit)
+                    break;
+            }
+        }
+        cand = prev[cand & WINDOW_MASK];
+    }
+    return best >= MIN_MATCH ? best : 0;
+}
+
+// Encodes data as one non-final block. Output stops at a bit boundary; the
+// partial byte is carried into the next call.
+void GzipEncoder::compress(const char* data, size_t len, String& out) {
+    if (!headerSent)
+        writeHeader(out);
+    if (len == 0)
+        return;
+    const CrcTable& table = crcTable();
+    for (size_t i = 0; i < len; ++i)
+        crc = table.entries[(crc ^ static_cast<unsigned char>(data[i])) & 0xFF] ^ (crc >> 8);
+    totalIn += len;
+
+    if (window.size() > WINDOW_SIZE) {
+        size_t drop = window.size() - WINDOW_SIZE;
+        window.erase(0, drop);
+        windowBase += static_cast<unsigned int>(drop);
+    }
+    size_t start = window.size();
+    window.append(data, len);
+    // the last positions of the previous call lacked MIN_MATCH bytes
+    for (size_t p = start >= 2 ? start - 2 : 0; p < start; ++p)
+        insertHash(p);
+
+    size_t        mark      = out.size();
+    unsigned long markBits  = bitBuffer;
+    int           markCount = bitCount;
+    putBits(0, 1, out); // BFINAL
+    putBits(1, 2, out); // BTYPE: fixed Huffman
+    size_t pos = start;
+    while (pos < window.size()) {
+        size_t distance = 0;
+        size_t length   = window.size() - pos >= MIN_MATCH ? findMatch(pos, distance) : 0;
+        if (length) {
+            putMatch(length, distance, out);
+            for (size_t i = 0; i < length; ++i)
+                insertHash(pos + i);
+            pos += length;
+        } else {
+            insertHash(pos);
+            putLiteral(static_cast<unsigned char>(window[pos]), out);
+            ++pos;
+        }
+    }
+    putBits(0, 7, out); // end of block
+    if (out.size() - mark > len + STORED_OVERHEAD) {
+        out.resize(mark);
+        bitBuffer = markBits;
+        bitCount  = markCount;
+        putStored(data, len, out);
+    }
+}
+
+// Incompressible input is copied in stored blocks, which start on a byte
+// boundary and carry at most 65535 bytes each.
+void GzipEncoder::putStored(const char* data, size_t len, String& out) {
+    while (len > 0) {
+        size_t block = len > 65535 ? 65535 : len;
+        putBits(0, 3, out); // BFINAL=0, BTYPE: stored
+        if (bitCount > 0)
+            putBits(0, 8 - bitCount, out);
+        out += static_cast<char>(block & 0xFF);
+        out += static_cast<char>(block >> 8);
+        out += static_cast<char>(~block & 0xFF);
+        out += static_cast<char>((~block >> 8) & 0xFF);
+        out.append(data, block);
+        data += block;
+        len -= block;
+    }
+}
+
+// Closes the stream: an empty final block, byte alignment, CRC32 and the
+// input size modulo 2^32, both little-endian.
+void GzipEncoder::finish(String& out) {
+    if (!headerSent)
+        writeHeader(out);
+    putBits(1, 1, out);
+    putBits(1, 2, out);
+    putBits(0, 7, out);
+    if (bitCount > 0)
+        putBits(0, 8 - bitCount, out);
+    unsigned long sum = crc ^ 0xFFFFFFFFUL;
+    for (int i = 0; i < 4; ++i)
+        out += static_cast<char>((sum >> (8 * i)) & 0xFF);
+    for (int i = 0; i < 4; ++i)
+        out += static_cast<char>((totalIn >> (8 * i)) & 0xFF);
+}
@@ -0,0 +1,43 @@
+#ifndef GZIP_ENCODER_HPP
+#define GZIP_ENCODER_HPP
+
+#include <vector>
+#include "Utils.hpp"
+
+// Streaming gzip (RFC 1952) writer over a small deflate (RFC 1951)
+// compressor: LZ77 with hash chains over a 32 KB window, emitted as
+// fixed-Huffman blocks. Each compress() call encodes its input as one block
+// that may refer back into earlier input, so a body can be compressed piece
+// by piece; `level` (1-9) only bounds how long the match search runs.
+class GzipEncoder {
+   public:
+    explicit GzipEncoder(int level = GZIP_DEFAULT_LEVEL);
+    GzipEncoder(const GzipEncoder& other);
+    GzipEncoder& operator=(const GzipEncoder& other);
+    ~GzipEncoder();
+
+    void compress(const char* data, size_t len, String& out);
+    void finish(String& out);
+
+   private:
+    void   writeHeader(String& out);
+    void   putBits(unsigned int value, int count, String& out);
+    void   putLiteral(unsigned char c, String& out);
+    void   putMatch(size_t length, size_t distance, String& out);
+    void   putStored(const char* data, size_t len, String& out);
+    size_t findMatch(size_t pos, size_t& distance) const;
+    void   insertHash(size_t pos);
+
+    int                       maxChain;
+    bool                      headerSent;
+    unsigned long             crc;
+    unsigned long             totalIn;
+    unsigned long             bitBuffer;
+    int                       bitCount;
+    String                    window; // up to 32 KB of history, then the current input
+    unsigned int              windowBase; // stream offset of window[0]
+    std::vector<unsigned int> head; // newest stream offset per hash
+    std::vector<unsigned int> prev; // previous offset with the same hash
+};
+
+#endif
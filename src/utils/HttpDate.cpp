@@ -0,0 +1,35 @@
+#include "HttpDate.hpp"
+
+#define DATE_PREFIX HEADER_DATE ": "
+#define DATE_OFFSET (sizeof(DATE_PREFIX) - 1)
+#define PROLOGUE_TAIL "\r\n" HEADER_SERVER ": " SERVER_SOFTWARE "\r\n"
+
+HttpDate::HttpDate() : cachedAt(-1), prologue() {
+    prologue.reserve(DATE_OFFSET + HTTP_DATE_LENGTH + sizeof(PROLOGUE_TAIL));
+    prologue.append(DATE_PREFIX);
+    prologue.append(HTTP_DATE_LENGTH, ' ');
+    prologue.append(PROLOGUE_TAIL);
+}
+
+HttpDate::HttpDate(const HttpDate& other) : cachedAt(other.cachedAt), prologue(other.prologue) {}
+
+HttpDate& HttpDate::operator=(const HttpDate& other) {
+    if (this != &other) {
+        cachedAt = other.cachedAt;
+        prologue = other.prologue;
+    }
+    return *this;
+}
+
+HttpDate::~HttpDate() {}
+
+void HttpDate::refresh(time_t now) {
+    if (now == cachedAt)
+        return;
+    cachedAt = now;
+    formatHttpDate(now, &prologue[DATE_OFFSET]);
+}
+
+const String& HttpDate::getPrologue() const {
+    return prologue;
+}
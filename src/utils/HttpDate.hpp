@@ -0,0 +1,25 @@
+#ifndef HTTP_DATE_HPP
+#define HTTP_DATE_HPP
+
+#include "Utils.hpp"
+
+// Per-event-loop cache of the response prologue that follows the status
+// line ("Date: ...\r\nServer: ...\r\n"). The loop calls refresh() once per
+// iteration; the Date bytes are rewritten in place only when the second
+// changes, so serializing a response just appends the cached string.
+class HttpDate {
+   public:
+    HttpDate();
+    HttpDate(const HttpDate& other);
+    HttpDate& operator=(const HttpDate& other);
+    ~HttpDate();
+
+    void          refresh(time_t now);
+    const String& getPrologue() const;
+
+   private:
+    time_t cachedAt;
+    String prologue;
+};
+
+#endif
@@ -1,9 +1,16 @@
 #include "Logger.hpp"
+#include "Mutex.hpp"
+
+// Serializes whole lines when several reactor threads log at once.
+static Mutex g_logMutex;
+
 bool Logger::info(const String& message) {
+    ScopedLock lock(g_logMutex);
     std::cout << "\033[34m[INFO]: " << message << "\033[0m" << std::endl;
     return true;
 }
 bool Logger::error(const String& message) {
+    ScopedLock lock(g_logMutex);
     std::cerr << "\033[31m[ERROR]: " << message << "\033[0m" << std::endl;
     return false;
 }
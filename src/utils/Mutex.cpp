@@ -0,0 +1,25 @@
+#include "Mutex.hpp"
+
+Mutex::Mutex() {
+    pthread_mutex_init(&mutex, NULL);
+}
+
+Mutex::~Mutex() {
+    pthread_mutex_destroy(&mutex);
+}
+
+void Mutex::lock() {
+    pthread_mutex_lock(&mutex);
+}
+
+void Mutex::unlock() {
+    pthread_mutex_unlock(&mutex);
+}
+
+ScopedLock::ScopedLock(Mutex& m) : mutex(m) {
+    mutex.lock();
+}
+
+ScopedLock::~ScopedLock() {
+    mutex.unlock();
+}
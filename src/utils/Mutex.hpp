@@ -0,0 +1,34 @@
+#ifndef MUTEX_HPP
+#define MUTEX_HPP
+
+#include <pthread.h>
+
+class Mutex {
+   public:
+    Mutex();
+    ~Mutex();
+
+    void lock();
+    void unlock();
+
+   private:
+    Mutex(const Mutex&);
+    Mutex& operator=(const Mutex&);
+
+    pthread_mutex_t mutex;
+};
+
+// Holds the mutex for the lifetime of the enclosing scope.
+class ScopedLock {
+   public:
+    explicit ScopedLock(Mutex& m);
+    ~ScopedLock();
+
+   private:
+    ScopedLock(const ScopedLock&);
+    ScopedLock& operator=(const ScopedLock&);
+
+    Mutex& mutex;
+};
+
+#endif
@@ -0,0 +1,107 @@
+#include "OpenFileCache.hpp"
+
+OpenFileCache::OpenFileCache() : maxEntries(0), inactive(0), valid(0), entries(), lru() {}
+
+OpenFileCache::~OpenFileCache() {
+    clear();
+}
+
+void OpenFileCache::configure(size_t _maxEntries, time_t _inactive, time_t _valid) {
+    clear();
+    maxEntries = _maxEntries;
+    inactive   = _inactive;
+    valid      = _valid;
+}
+
+bool OpenFileCache::isEnabled() const {
+    return maxEntries > 0;
+}
+
+// stat()s path and, for a regular file, opens it unless `previous` already
+// holds an fd for the same unchanged file.
+bool OpenFileCache::load(const String& path, CachedFile& file, const CachedFile* previous) const {
+    struct stat st;
+    if (stat(path.c_str(), &st) != 0)
+        return false;
+    file.type   = getFileType(st);
+    file.size   = st.st_size;
+    file.mtime  = st.st_mtime;
+    file.inode  = st.st_ino;
+    file.device = st.st_dev;
+    file.fd     = INVALID_FD;
+    if (file.type != SINGLEFILE)
+        return true;
+    if (previous && previous->fd != INVALID_FD && previous->inode == file.inode && previous->device == file.device
+        && previous->size == file.size && previous->mtime == file.mtime) {
+        file.fd = previous->fd;
+        return true;
+    }
+    file.fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    return true;
+}
+
+void OpenFileCache::erase(EntryMap::iterator it) {
+    if (it->second.file.fd != INVALID_FD)
+        close(it->second.file.fd);
+    lru.erase(it->second.lru);
+    entries.erase(it);
+}
+
+// Returns the cached entry for path (revalidating it when stale), or NULL
+// when the path does not exist. The pointer is valid until the next call.
+const CachedFile* OpenFileCache::lookup(const String& path, time_t now) {
+    if (!isEnabled())
+        return NULL;
+    EntryMap::iterator it = entries.find(path);
+    if (it != entries.end()) {
+        Entry& entry = it->second;
+        if (now - entry.validatedAt >= valid) {
+            CachedFile fresh;
+            if (!load(path, fresh, &entry.file)) {
+                erase(it);
+                return NULL;
+            }
+            if (entry.file.fd != INVALID_FD && entry.file.fd != fresh.fd)
+                close(entry.file.fd);
+            entry.file        = fresh;
+            entry.validatedAt = now;
+        }
+        entry.lastUsed = now;
+        lru.splice(lru.begin(), lru, entry.lru);
+        return &entry.file;
+    }
+    CachedFile file;
+    if (!load(path, file, NULL))
+        return NULL;
+    while (entries.size() >= maxEntries && !lru.empty())
+        erase(entries.find(lru.back()));
+    lru.push_front(path);
+    Entry& entry      = entries[path];
+    entry.file        = file;
+    entry.validatedAt = now;
+    entry.lastUsed    = now;
+    entry.lru         = lru.begin();
+    return &entry.file;
+}
+
+// Drops entries not used for `inactive` seconds; the LRU tail is oldest.
+void OpenFileCache::expire(time_t now) {
+    while (!lru.empty()) {
+        EntryMap::iterator it = entries.find(lru.back());
+        if (now - it->second.lastUsed < inactive)
+            break;
+        erase(it);
+    }
+}
+
+void OpenFileCache::clear() {
+    for (EntryMap::iterator it = entries.begin(); it != entries.end(); ++it)
+        if (it->second.file.fd != INVALID_FD)
+            close(it->second.file.fd);
+    entries.clear();
+    lru.clear();
+}
+
+size_t OpenFileCache::size() const {
+    return entries.size();
+}
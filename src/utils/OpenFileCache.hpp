@@ -0,0 +1,62 @@
+#ifndef OPEN_FILE_CACHE_HPP
+#define OPEN_FILE_CACHE_HPP
+
+#include <sys/stat.h>
+#include <list>
+#include <map>
+#include "Utils.hpp"
+
+struct CachedFile {
+    int      fd; // open O_RDONLY for regular files, INVALID_FD otherwise
+    FileType type;
+    off_t    size;
+    time_t   mtime;
+    ino_t    inode;
+    dev_t    device;
+};
+
+// open_file_cache: metadata (and an open fd for regular files) keyed by
+// resolved path, so hot paths are served without stat()/open(). Entries are
+// revalidated with one stat() once they are older than `valid` seconds,
+// dropped after `inactive` seconds without a hit, and evicted LRU-first once
+// `max` entries are held. Missing paths are not cached.
+//
+// One cache per event loop: it is not shared between threads, so no lock.
+// Callers that keep the file beyond the current request dup() the fd.
+class OpenFileCache {
+   public:
+    OpenFileCache();
+    ~OpenFileCache();
+
+    void              configure(size_t maxEntries, time_t inactive, time_t valid);
+    bool              isEnabled() const;
+    const CachedFile* lookup(const String& path, time_t now);
+    void              expire(time_t now);
+    void              clear();
+    size_t            size() const;
+
+   private:
+    typedef std::list<String> LruList;
+
+    struct Entry {
+        CachedFile        file;
+        time_t            validatedAt;
+        time_t            lastUsed;
+        LruList::iterator lru;
+    };
+    typedef std::map<String, Entry> EntryMap;
+
+    OpenFileCache(const OpenFileCache&);
+    OpenFileCache& operator=(const OpenFileCache&);
+
+    bool load(const String& path, CachedFile& file, const CachedFile* previous) const;
+    void erase(EntryMap::iterator it);
+
+    size_t   maxEntries;
+    time_t   inactive;
+    time_t   valid;
+    EntryMap entries;
+    LruList  lru; // most recently used first
+};
+
+#endif
@@ -2,11 +2,21 @@
 
 SessionManager::SessionManager() {}
 
-SessionManager::SessionManager(const SessionManager& other) : sessions(other.sessions) {}
+SessionManager::SessionManager(const SessionManager& other) : sessions(), mutex() {
+    ScopedLock lock(other.mutex);
+    sessions = other.sessions;
+}
 
 SessionManager& SessionManager::operator=(const SessionManager& other) {
-    if (this != &other)
-        sessions = other.sessions;
+    if (this != &other) {
+        SessionMap copy;
+        {
+            ScopedLock lock(other.mutex);
+            copy = other.sessions;
+        }
+        ScopedLock lock(mutex);
+        sessions.swap(copy);
+    }
     return *this;
 }
 
@@ -17,7 +27,8 @@ bool SessionManager::isIdTaken(const String& id) const {
 }
 
 String SessionManager::createSession(const String& userId) {
-    String id;
+    ScopedLock lock(mutex);
+    String     id;
     do {
         id = generateGUID();
     } while (isIdTaken(id));
@@ -27,20 +38,23 @@ String SessionManager::createSession(const String& userId) {
     return id;
 }
 
-SessionResult* SessionManager::getSession(const String& sessionId) {
+bool SessionManager::getSession(const String& sessionId, SessionResult& out) {
+    ScopedLock           lock(mutex);
     SessionMap::iterator it = sessions.find(sessionId);
     if (it == sessions.end())
-        return NULL;
+        return false;
     if (it->second.isExpired(SESSION_TIMEOUT)) {
         Logger::info("[SESSION]: Expired session " + sessionId.substr(0, 8) + "...");
         sessions.erase(it);
-        return NULL;
+        return false;
     }
     it->second.updateTime();
-    return &it->second;
+    out = it->second;
+    return true;
 }
 
 bool SessionManager::removeSession(const String& sessionId) {
+    ScopedLock           lock(mutex);
     SessionMap::iterator it = sessions.find(sessionId);
     if (it == sessions.end())
         return false;
@@ -50,6 +64,7 @@ bool SessionManager::removeSession(const String& sessionId) {
 }
 
 void SessionManager::cleanupExpiredSessions(int timeoutSeconds) {
+    ScopedLock           lock(mutex);
     SessionMap::iterator it = sessions.begin();
     while (it != sessions.end()) {
         if (it->second.isExpired(timeoutSeconds)) {
@@ -64,6 +79,7 @@ void SessionManager::cleanupExpiredSessions(int timeoutSeconds) {
 }
 
 bool SessionManager::isValid(const String& sessionId) const {
+    ScopedLock                 lock(mutex);
     SessionMap::const_iterator it = sessions.find(sessionId);
     if (it == sessions.end())
         return false;
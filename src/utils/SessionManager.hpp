@@ -1,6 +1,7 @@
 #ifndef SESSION_MANAGER_HPP
 #define SESSION_MANAGER_HPP
 
+#include "Mutex.hpp"
 #include "Utils.hpp"
 #include "SessionResult.hpp"
 
@@ -15,7 +16,7 @@ class SessionManager
     ~SessionManager();
 
     String   createSession(const String& userId);
-    SessionResult   * getSession(const String& sessionId);
+    bool     getSession(const String& sessionId, SessionResult& out);
     bool     removeSession(const String& sessionId);
     void     cleanupExpiredSessions(int timeoutSeconds);
 
@@ -23,7 +24,8 @@ class SessionManager
     static String buildSetCookieHeader(const String& sessionId);
 
    private:
-    SessionMap sessions;
+    SessionMap    sessions;
+    mutable Mutex mutex; // sessions are shared by all reactor threads
     bool   isIdTaken(const String& id) const;
 };
 
@@ -1,10 +1,12 @@
 #ifndef TYPES_HPP
 #define TYPES_HPP
 
+#include <ctime>
 #include <map>
 #include <string>
 #include <vector>
 
+class HttpConfig;
 class ServerConfig;
 class LocationConfig;
 class ListenAddress;
@@ -21,10 +23,13 @@ typedef std::map<String, VectorServerConfig> ListenerToConfigsMap;
 typedef std::vector<LocationConfig>          VectorLocationConfig;
 typedef std::vector<ListenAddress>           VectorListenAddress;
 typedef std::map<int, String>                MapIntString;
+typedef std::map<String, time_t>             MapStringTime;
 typedef std::map<int, Client*>               MapIntClientPtr;
 typedef std::map<int, Server*>               MapIntServerPtr;
 typedef std::map<int, VectorServerConfig>    MapIntVectorServerConfig;
 
+typedef bool (HttpConfig::*HttpSetter)(const VectorString&);
+typedef std::map<String, HttpSetter> HttpDirectiveMap;
 typedef bool (ServerConfig::*ServerSetter)(const VectorString&);
 typedef std::map<String, ServerSetter> ServerDirectiveMap;
 typedef bool (LocationConfig::*LocationSetter)(const VectorString&);
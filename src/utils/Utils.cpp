@@ -1,4 +1,6 @@
 #include "Utils.hpp"
+#include <cstdio>
+#include <cstring>
 
 time_t getCurrentTime() {
     return time(NULL);
@@ -12,53 +14,101 @@ time_t getElapsedSeconds(const time_t& start, const time_t& end) {
     return end - start;
 }
 
-bool isLeapYear(int year) {
-    return (year % 4 == 0 && year % 100 != 0) || (year % 400 == 0);
+static void putTwoDigits(char* out, int n) {
+    out[0] = static_cast<char>('0' + n / 10);
+    out[1] = static_cast<char>('0' + n % 10);
 }
 
-static String padTwo(int n) {
-    return (n < 10 ? "0" : "") + typeToString(n);
-}
-
-String formatDateTime(time_t t) {
-    static const int   MONTH_DAYS[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
-    static const char* WEEKDAYS[]   = {"Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat"};
-    static const char* MONTHS[]     = {"Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"};
+// Writes the IMF-fixdate form ("Sun, 06 Nov 1994 08:49:37 GMT") into out,
+// which must hold HTTP_DATE_LENGTH bytes. The civil date is derived in
+// closed form from the day count (era/day-of-era decomposition), so the cost
+// does not grow with the year.
+void formatHttpDate(time_t t, char* out) {
+    static const char WEEKDAYS[] = "SunMonTueWedThuFriSat";
+    static const char MONTHS[]   = "JanFebMarAprMayJunJulAugSepOctNovDec";
 
-    long daysSinceEpoch = t / SECONDS_PER_DAY;
-    long secsToday      = t % SECONDS_PER_DAY;
-    int  weekday        = (4 + daysSinceEpoch) % 7;
+    long days = t / SECONDS_PER_DAY;
+    long secs = t % SECONDS_PER_DAY;
+    if (secs < 0) {
+        secs += SECONDS_PER_DAY;
+        --days;
+    }
+    int weekday = static_cast<int>((4 + days) % 7);
     if (weekday < 0)
         weekday += 7;
-    int  year          = 1970;
-    long remainingDays = daysSinceEpoch;
-    while (true) {
-        int daysInYear = isLeapYear(year) ? 366 : 365;
-        if (remainingDays >= daysInYear) {
-            remainingDays -= daysInYear;
-            ++year;
-        } else {
-            break;
-        }
-    }
-    int month = 0;
-    while (month < 12) {
-        int daysInMonth = MONTH_DAYS[month];
-        if (month == 1 && isLeapYear(year))
-            daysInMonth = 29;
-        if (remainingDays >= daysInMonth) {
-            remainingDays -= daysInMonth;
-            ++month;
-        } else
-            break;
-    }
-    int day    = static_cast<int>(remainingDays) + 1;
-    int hour   = static_cast<int>(secsToday / SECONDS_PER_HOUR);
-    int minute = static_cast<int>((secsToday % SECONDS_PER_HOUR) / SECONDS_PER_MIN);
-    int second = static_cast<int>(secsToday % SECONDS_PER_MIN);
 
-    return String(WEEKDAYS[weekday]) + ", " + padTwo(day) + " " + MONTHS[month] + " "
-         + typeToString(year) + " " + padTwo(hour) + ":" + padTwo(minute) + ":" + padTwo(second) + " GMT";
+    long     z     = days + 719468;
+    long     era   = (z >= 0 ? z : z - 146096) / 146097;
+    unsigned doe   = static_cast<unsigned>(z - era * 146097);
+    unsigned yoe   = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    unsigned doy   = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    unsigned mp    = (5 * doy + 2) / 153;
+    int      day   = static_cast<int>(doy - (153 * mp + 2) / 5 + 1);
+    int      month = static_cast<int>(mp < 10 ? mp + 2 : mp - 10);
+    long     year  = static_cast<long>(yoe) + era * 400 + (month < 2 ? 1 : 0);
+    if (year < 0)
+        year = 0;
+    if (year > 9999)
+        year = 9999;
+
+    std::memcpy(out, WEEKDAYS + weekday * 3, 3);
+    out[3] = ',';
+    out[4] = ' ';
+    putTwoDigits(out + 5, day);
+    out[7] = ' ';
+    std::memcpy(out + 8, MONTHS + month * 3, 3);
+    out[11] = ' ';
+    putTwoDigits(out + 12, static_cast<int>(year / 100));
+    putTwoDigits(out + 14, static_cast<int>(year % 100));
+    out[16] = ' ';
+    putTwoDigits(out + 17, static_cast<int>(secs / SECONDS_PER_HOUR));
+    out[19] = ':';
+    putTwoDigits(out + 20, static_cast<int>((secs % SECONDS_PER_HOUR) / SECONDS_PER_MIN));
+    out[22] = ':';
+    putTwoDigits(out + 23, static_cast<int>(secs % SECONDS_PER_MIN));
+    std::memcpy(out + 25, " GMT", 4);
+}
+
+String formatDateTime(time_t t) {
+    char buf[HTTP_DATE_LENGTH];
+    formatHttpDate(t, buf);
+    return String(buf, HTTP_DATE_LENGTH);
+}
+
+// Inverse of the decomposition above: days since the epoch for a civil
+// date (month 1-12).
+static long daysFromCivil(long year, int month, int day) {
+    year -= month <= 2 ? 1 : 0;
+    long     era = (year >= 0 ? year : year - 399) / 400;
+    unsigned yoe = static_cast<unsigned>(year - era * 400);
+    unsigned doy = static_cast<unsigned>((153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1);
+    unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + static_cast<long>(doe) - 719468;
+}
+
+// Accepts the three formats RFC 9110 requires of recipients: IMF-fixdate
+// ("Sun, 06 Nov 1994 08:49:37 GMT"), RFC 850 ("Sunday, 06-Nov-94 08:49:37
+// GMT") and asctime ("Sun Nov  6 08:49:37 1994").
+bool parseHttpDate(const String& value, time_t& out) {
+    static const char MONTHS[] = "JanFebMarAprMayJunJulAugSepOctNovDec";
+    char              mon[4]   = {0};
+    int               day, year, hour, min, sec;
+    const char*       s        = value.c_str();
+    bool              parsed   = std::sscanf(s, "%*3s, %2d %3s %4d %2d:%2d:%2d GMT", &day, mon, &year, &hour, &min, &sec) == 6;
+    if (!parsed && std::sscanf(s, "%*[A-Za-z], %2d-%3s-%2d %2d:%2d:%2d GMT", &day, mon, &year, &hour, &min, &sec) == 6) {
+        parsed = true;
+        year += year < 70 ? 2000 : 1900;
+    }
+    if (!parsed && std::sscanf(s, "%*3s %3s %d %2d:%2d:%2d %4d", mon, &day, &hour, &min, &sec, &year) != 6)
+        return false;
+    const char* found = std::strstr(MONTHS, mon);
+    if (std::strlen(mon) != 3 || !found || (found - MONTHS) % 3 != 0)
+        return false;
+    int month = static_cast<int>(found - MONTHS) / 3 + 1;
+    if (day < 1 || day > 31 || hour > 23 || min > 59 || sec > 60 || hour < 0 || min < 0 || sec < 0)
+        return false;
+    out = static_cast<time_t>(daysFromCivil(year, month, day)) * SECONDS_PER_DAY + hour * SECONDS_PER_HOUR + min * SECONDS_PER_MIN + sec;
+    return true;
 }
 
 String toUpperWords(const String& str) {
@@ -167,7 +217,7 @@ String generateGUID() {
 }
 
 bool splitByChar(const String& line, String& key, String& value, char endChar, bool reverse) {
-    size_t pos = reverse ? line.rfind(endChar) : line.find(endChar);
+    size_t pos = reverse ? line.rfind(endChar) : findByte(line, endChar);
     if (pos == String::npos || pos >= line.size()) {
         return false;
     }
@@ -184,6 +234,16 @@ bool splitByChar(const String& line, String& key, String& value, char endChar, b
     return true;
 }
 
+String joinStrings(const VectorString& values, const String& separator) {
+    String joined;
+    for (size_t i = 0; i < values.size(); ++i) {
+        if (i > 0)
+            joined += separator;
+        joined += values[i];
+    }
+    return joined;
+}
+
 bool splitByString(const String& line, VectorString& values, const String& delimiter) {
     size_t start = 0;
     size_t end   = line.find(delimiter);
@@ -592,7 +652,7 @@ bool parseMultipartFormData(const String& body, const String& boundary, String&
 
     String startBoundary = "--" + boundary;
     // 1. Find Start
-    size_t partStart = body.find(startBoundary);
+    size_t partStart = findSequence(body, startBoundary);
     if (partStart == String::npos)
         return false;
     partStart += startBoundary.length();
@@ -602,7 +662,7 @@ bool parseMultipartFormData(const String& body, const String& boundary, String&
         partStart += 2;
 
     // 2. Find End of this part (next boundary)
-    size_t partEnd = body.find(startBoundary, partStart);
+    size_t partEnd = findSequence(body, startBoundary, partStart);
     if (partEnd == String::npos)
         return false;
 
@@ -610,7 +670,7 @@ bool parseMultipartFormData(const String& body, const String& boundary, String&
     String part = body.substr(partStart, partEnd - partStart);
 
     // 3. Separate Headers and Content
-    size_t headerEnd = part.find(DOUBLE_CRLF);
+    size_t headerEnd = findSequence(part, DOUBLE_CRLF);
     if (headerEnd == String::npos)
         return false;
 
@@ -656,17 +716,17 @@ bool parseHexChunkSize(const String& sizeLine, unsigned long& chunkSize) {
     return true;
 }
 
-bool decodeChunkedBody(const String& chunkedBody, String& decodedBody) {
+bool decodeChunkedBody(const char* data, size_t size, String& decodedBody) {
     decodedBody.clear();
     size_t pos      = 0;
-    size_t totalLen = chunkedBody.size();
+    size_t totalLen = size;
 
     while (pos < totalLen) {
-        size_t lineEnd = chunkedBody.find("\r\n", pos);
+        size_t lineEnd = findCrlf(data, size, pos);
         if (lineEnd == String::npos)
             return false;
 
-        String sizeLine = chunkedBody.substr(pos, lineEnd - pos);
+        String sizeLine(data + pos, lineEnd - pos);
         size_t semiPos  = sizeLine.find(';');
         if (semiPos != String::npos)
             sizeLine = sizeLine.substr(0, semiPos);
@@ -682,7 +742,7 @@ bool decodeChunkedBody(const String& chunkedBody, String& decodedBody) {
         // Handle last chunk (0)
         if (chunkSize == 0) {
             while (pos < totalLen) {
-                size_t crlfPos = chunkedBody.find("\r\n", pos);
+                size_t crlfPos = findCrlf(data, size, pos);
                 if (crlfPos == String::npos)
                     return false;
                 if (crlfPos == pos) {
@@ -699,10 +759,10 @@ bool decodeChunkedBody(const String& chunkedBody, String& decodedBody) {
             return false;
 
         // Append chunk data
-        decodedBody.append(chunkedBody, pos, chunkSize);
+        decodedBody.append(data + pos, chunkSize);
         pos += chunkSize;
 
-        if (chunkedBody.substr(pos, 2) != "\r\n")
+        if (std::memcmp(data + pos, CRLF, 2) != 0)
             return false;
         pos += 2;
     }
@@ -710,18 +770,18 @@ bool decodeChunkedBody(const String& chunkedBody, String& decodedBody) {
     return false;
 }
 
-bool decodeChunkedIncremental(const String& buffer, String& decoded, bool& done, size_t& consumed) {
+bool decodeChunkedIncremental(const char* data, size_t size, String& decoded, bool& done, size_t& consumed) {
     done       = false;
     consumed   = 0;
     size_t pos = 0;
 
-    while (pos < buffer.size()) {
-        size_t lineEnd = buffer.find("\r\n", pos);
+    while (pos < size) {
+        size_t lineEnd = findCrlf(data, size, pos);
         if (lineEnd == String::npos)
             break;
 
         unsigned long chunkSize = 0;
-        const char* sStart = buffer.c_str() + pos;
+        const char* sStart = data + pos;
         size_t sLen = lineEnd - pos;
         // Parse hex manually to avoid substr
         bool hexValid = false;
@@ -740,30 +800,30 @@ bool decodeChunkedIncremental(const String& buffer, String& decoded, bool& done,
 
         size_t dataStart = lineEnd + 2;
         if (chunkSize == 0) {
-            if (dataStart + 2 > buffer.size()) break;
+            if (dataStart + 2 > size) break;
             consumed = dataStart + 2;
             done     = true;
             break;
         }
-        if (dataStart + chunkSize + 2 > buffer.size()) break;
+        if (dataStart + chunkSize + 2 > size) break;
 
-        decoded.append(buffer, dataStart, chunkSize);
+        decoded.append(data + dataStart, chunkSize);
         pos      = dataStart + chunkSize + 2;
         consumed = pos;
     }
     return true;
 }
 
-size_t findChunkedBodyEnd(const String& data) {
+size_t findChunkedBodyEnd(const char* data, size_t size) {
     size_t pos      = 0;
-    size_t totalLen = data.size();
+    size_t totalLen = size;
 
     while (pos < totalLen) {
-        size_t lineEnd = data.find("\r\n", pos);
+        size_t lineEnd = findCrlf(data, size, pos);
         if (lineEnd == String::npos)
             return String::npos;
 
-        String sizeLine = data.substr(pos, lineEnd - pos);
+        String sizeLine(data + pos, lineEnd - pos);
         size_t semiPos  = sizeLine.find(';');
         if (semiPos != String::npos)
             sizeLine = sizeLine.substr(0, semiPos);
@@ -780,7 +840,7 @@ size_t findChunkedBodyEnd(const String& data) {
 
         if (chunkSize == 0) {
             while (pos < totalLen) {
-                size_t crlfPos = data.find("\r\n", pos);
+                size_t crlfPos = findCrlf(data, size, pos);
                 if (crlfPos == String::npos)
                     return String::npos;
                 if (crlfPos == pos) {
@@ -797,7 +857,7 @@ size_t findChunkedBodyEnd(const String& data) {
 
         pos += chunkSize;
 
-        if (data.substr(pos, 2) != "\r\n")
+        if (std::memcmp(data + pos, CRLF, 2) != 0)
             return String::npos;
         pos += 2;
     }
@@ -829,3 +889,110 @@ bool requireSingleValue(const VectorString& v, const String& directive) {
         return Logger::error(directive + " takes exactly one value");
     return true;
 }
+
+// Whether an Accept-Encoding value allows `coding`, named or through "*";
+// a q=0 weight refuses it.
+bool acceptsEncoding(const String& acceptEncoding, const String& coding) {
+    bool   wildcard = false;
+    size_t pos      = 0;
+    while (pos < acceptEncoding.size()) {
+        size_t end = acceptEncoding.find(',', pos);
+        if (end == String::npos)
+            end = acceptEncoding.size();
+        String item    = acceptEncoding.substr(pos, end - pos);
+        size_t semi    = item.find(';');
+        String name    = toLowerWords(trimSpaces(item.substr(0, semi)));
+        bool   allowed = true;
+        pos            = end + 1;
+        if (semi != String::npos) {
+            String param = trimSpaces(item.substr(semi + 1));
+            if (param.size() > 2 && (param[0] == 'q' || param[0] == 'Q') && param[1] == '=')
+                allowed = std::strtod(param.c_str() + 2, NULL) > 0;
+        }
+        if (name == coding)
+            return allowed;
+        if (name == "*")
+            wildcard = allowed;
+    }
+    return wildcard;
+}
+
+// If-None-Match: "*" or a comma-separated list of tags, compared weakly
+// (a W/ prefix on either side is ignored).
+bool matchesEntityTag(const String& ifNoneMatch, const String& etag) {
+    String tag = etag.compare(0, 2, "W/") == 0 ? etag.substr(2) : etag;
+    size_t pos = 0;
+    while (pos < ifNoneMatch.size()) {
+        size_t end = ifNoneMatch.find(',', pos);
+        if (end == String::npos)
+            end = ifNoneMatch.size();
+        String item = trimSpaces(ifNoneMatch.substr(pos, end - pos));
+        pos         = end + 1;
+        if (item.compare(0, 2, "W/") == 0)
+            item.erase(0, 2);
+        if (item == "*" || item == tag)
+            return true;
+    }
+    return false;
+}
+
+// "30", "30s", "5m", "2h" or "1d" as seconds.
+bool parseSeconds(const String& value, time_t& out) {
+    if (value.empty())
+        return false;
+    String digits     = value;
+    long   multiplier = 1;
+    char   unit       = value[value.size() - 1];
+    if (!std::isdigit(static_cast<unsigned char>(unit))) {
+        digits = value.substr(0, value.size() - 1);
+        if (unit == 's')
+            multiplier = 1;
+        else if (unit == 'm')
+            multiplier = SECONDS_PER_MIN;
+        else if (unit == 'h')
+            multiplier = SECONDS_PER_HOUR;
+        else if (unit == 'd')
+            multiplier = SECONDS_PER_DAY;
+        else
+            return false;
+    }
+    long parsed;
+    if (digits.empty() || !stringToType<long>(digits, parsed) || parsed < 0 || parsed > MAX_CONFIG_SECONDS / multiplier)
+        return false;
+    out = static_cast<time_t>(parsed * multiplier);
+    return true;
+}
+
+// "512", "64k", "8m" or "1g" as bytes.
+bool parseByteSize(const String& value, size_t& out) {
+    if (value.empty())
+        return false;
+    String digits     = value;
+    size_t multiplier = 1;
+    char   unit       = static_cast<char>(std::tolower(static_cast<unsigned char>(value[value.size() - 1])));
+    if (!std::isdigit(static_cast<unsigned char>(unit))) {
+        digits = value.substr(0, value.size() - 1);
+        if (unit == 'k')
+            multiplier = KB;
+        else if (unit == 'm')
+            multiplier = MB;
+        else if (unit == 'g')
+            multiplier = 1024 * MB;
+        else
+            return false;
+    }
+    long parsed;
+    if (digits.empty() || !stringToType<long>(digits, parsed) || parsed < 0 || static_cast<size_t>(parsed) > MAX_CONFIG_BYTES / multiplier)
+        return false;
+    out = static_cast<size_t>(parsed) * multiplier;
+    return true;
+}
+
+// Empties the string and gives its storage back when it grew beyond
+// maxCapacity; smaller buffers keep their capacity for reuse.
+void releaseIfLarger(String& s, size_t maxCapacity) {
+    if (s.capacity() > maxCapacity)
+        String().swap(s);
+    else
+        s.clear();
+}
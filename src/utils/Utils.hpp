@@ -9,6 +9,7 @@
 #include <fstream>
 #include <iostream>
 #include <sstream>
+#include "ByteScan.hpp"
 #include "Constants.hpp"
 #include "Enums.hpp"
 #include "Logger.hpp"
@@ -18,7 +19,9 @@
 time_t getCurrentTime();
 void   updateTime(time_t& t);
 time_t getElapsedSeconds(const time_t& start, const time_t& end);
+void   formatHttpDate(time_t t, char* out);
 String formatDateTime(time_t t = getCurrentTime());
+bool   parseHttpDate(const String& value, time_t& out);
 // --- String Methods ---
 String toUpperWords(const String& str);
 String toLowerWords(const String& str);
@@ -26,6 +29,7 @@ String trimSpaces(const String& s);
 String trimQuotes(const String& s);
 String trimSpacesComments(const String& s);
 String trimTrailingChar(const String& v, char c);
+String joinStrings(const VectorString& values, const String& separator);
 bool   splitByChar(const String& line, String& key, String& value, char endChar, bool reverse = false);
 bool   splitByString(const String& line, VectorString& values, const String& delimiter);
 String htmlEntities(const String& str);
@@ -63,12 +67,17 @@ String getHttpStatusMessage(int code);
 // --- Header/Body Parsing ---
 String extractFilenameFromHeader(const String& contentDisposition);
 String extractBoundaryFromContentType(const String& contentType);
+bool   acceptsEncoding(const String& acceptEncoding, const String& coding);
+bool   matchesEntityTag(const String& ifNoneMatch, const String& etag);
 bool   parseMultipartFormData(const String& body, const String& boundary, String& filename, String& fileContent);
 bool   parseHexChunkSize(const String& sizeLine, unsigned long& chunkSize);
-bool   decodeChunkedBody(const String& chunkedBody, String& decodedBody);
-bool   decodeChunkedIncremental(const String& buffer, String& decoded, bool& done, size_t& consumed);
-size_t findChunkedBodyEnd(const String& data);
+bool   decodeChunkedBody(const char* data, size_t size, String& decodedBody);
+bool   decodeChunkedIncremental(const char* data, size_t size, String& decoded, bool& done, size_t& consumed);
+size_t findChunkedBodyEnd(const char* data, size_t size);
 bool   requireSingleValue(const VectorString& v, const String& directive);
+bool   parseSeconds(const String& value, time_t& out);
+bool   parseByteSize(const String& value, size_t& out);
+void   releaseIfLarger(String& s, size_t maxCapacity);
 
 //! --- Templates ---
 template <typename MapType, typename KeyType>
@@ -18,6 +18,12 @@ void printLocation(const LocationConfig& loc, const ssize_t& resolvedBody) {
     std::cout << "  Location: " << loc.getPath() << "\n";
     std::cout << "    root       : " << loc.getRoot() << "\n";
     std::cout << "    autoindex  : " << (loc.getAutoIndex() ? "on" : "off") << "\n";
+    if (loc.getGzipStatic() || loc.getBrotliStatic())
+        std::cout << "    precomp    :" << (loc.getGzipStatic() ? " gzip" : "") << (loc.getBrotliStatic() ? " br" : "") << "\n";
+    if (loc.getGzip())
+        std::cout << "    gzip       : level " << loc.getGzipCompLevel() << ", min " << loc.getGzipMinLength() << "\n";
+    if (loc.getExpires("text/html") != EXPIRES_OFF || !loc.getCacheControl("text/html").empty())
+        std::cout << "    expires    : " << loc.getExpires("text/html") << " " << loc.getCacheControl("text/html") << "\n";
     std::cout << "    return     : " << (loc.getIsRedirect() ? (loc.getRedirectValue() + " " + typeToString<int>(loc.getRedirectCode())) : "none")
               << "\n";
     for (size_t i = 0; i < loc.getAllowedMethods().size(); i++) {
@@ -81,6 +87,18 @@ int main(int ac, char** av) {
     printLine();
     std::cout << "HTTP\n";
     std::cout << "  client_max_body_size : " << parser.getHttpClientMaxBody() << "\n";
+    std::cout << "  event_backend        : " << parser.getHttpConfig().getEventBackendName() << "\n";
+    std::cout << "  worker_processes     : " << parser.getHttpConfig().getWorkerProcesses() << "\n";
+    std::cout << "  worker_cpu_affinity  : " << (parser.getHttpConfig().getWorkerCpuAffinity() ? "auto" : "off") << "\n";
+    std::cout << "  worker_threads       : " << parser.getHttpConfig().getWorkerThreads() << "\n";
+    std::cout << "  accept_budget        : " << parser.getHttpConfig().getAcceptBudget() << "\n";
+    std::cout << "  worker_connections   : " << parser.getHttpConfig().getWorkerConnections() << "\n";
+    std::cout << "  pipeline_depth       : " << parser.getHttpConfig().getPipelineDepth() << "\n";
+    std::cout << "  open_file_cache      : max=" << parser.getHttpConfig().getOpenFileCacheMax()
+              << " inactive=" << parser.getHttpConfig().getOpenFileCacheInactive()
+              << " valid=" << parser.getHttpConfig().getOpenFileCacheValid() << "\n";
+    std::cout << "  content_cache        : size=" << parser.getHttpConfig().getContentCacheSize()
+              << " max_file=" << parser.getHttpConfig().getContentCacheMaxFile() << "\n";
 
     /* ------------------------------------------------
      * Servers
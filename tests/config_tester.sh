@@ -1341,6 +1341,574 @@ http {
         }
     }
 }
+EOF
+
+    # ----------------------------------------------------------
+    # HTTP-LEVEL DIRECTIVES
+    # ----------------------------------------------------------
+
+    # 100. event_backend poll
+    cat > "$TEST_DIR/100_event_backend_poll.conf" << 'EOF'
+http {
+    event_backend poll;
+    server {
+        listen localhost:8080;
+        root /var/www;
+        location / {
+            index index.html;
+        }
+    }
+}
+EOF
+
+    # 101. invalid event_backend
+    cat > "$TEST_DIR/101_event_backend_invalid.conf" << 'EOF'
+http {
+    event_backend select;
+    server {
+        listen localhost:8080;
+        root /var/www;
+        location / {
+            index index.html;
+        }
+    }
+}
+EOF
+
+    # 102. duplicate event_backend
+    cat > "$TEST_DIR/102_event_backend_dup.conf" << 'EOF'
+http {
+    event_backend epoll;
+    event_backend poll;
+    server {
+        listen localhost:8080;
+        root /var/www;
+        location / {
+            index index.html;
+        }
+    }
+}
+EOF
+
+    # 103. worker processes auto
+    cat > "$TEST_DIR/103_worker_processes_auto.conf" << 'EOF'
+http {
+    worker_processes auto;
+    worker_cpu_affinity auto;
+    server {
+        listen localhost:8080;
+        root /var/www;
+        location / {
+            index index.html;
+        }
+    }
+}
+EOF
+
+    # 104. worker processes zero
+    cat > "$TEST_DIR/104_worker_processes_zero.conf" << 'EOF'
+http {
+    worker_processes 0;
+    server {
+        listen localhost:8080;
+        root /var/www;
+        location / {
+            index index.html;
+        }
+    }
+}
+EOF
+
+    # 105. worker processes dup
+    cat > "$TEST_DIR/105_worker_processes_dup.conf" << 'EOF'
+http {
+    worker_processes 2;
+    worker_processes 4;
+    server {
+        listen localhost:8080;
+        root /var/www;
+        location / {
+            index index.html;
+        }
+    }
+}
+EOF
+
+    # 106. worker cpu affinity invalid
+    cat > "$TEST_DIR/106_worker_cpu_affinity_invalid.conf" << 'EOF'
+http {
+    worker_cpu_affinity 0101;
+    server {
+        listen localhost:8080;
+        root /var/www;
+        location / {
+            index index.html;
+        }
+    }
+}
+EOF
+
+    # 107. worker threads
+    cat > "$TEST_DIR/107_worker_threads.conf" << 'EOF'
+http {
+    worker_threads 4;
+    server {
+        listen localhost:8080;
+        root /var/www;
+        location / {
+            index index.html;
+        }
+    }
+}
+EOF
+
+    # 108. worker threads invalid
+    cat > "$TEST_DIR/108_worker_threads_invalid.conf" << 'EOF'
+http {
+    worker_threads many;
+    server {
+        listen localhost:8080;
+        root /var/www;
+        location / {
+            index index.html;
+        }
+    }
+}
+EOF
+
+    # 109. worker threads dup
+    cat > "$TEST_DIR/109_worker_threads_dup.conf" << 'EOF'
+http {
+    worker_threads 2;
+    worker_threads 2;
+    server {
+        listen localhost:8080;
+        root /var/www;
+        location / {
+            index index.html;
+        }
+    }
+}
+EOF
+
+    # 110. accept budget
+    cat > "$TEST_DIR/110_accept_budget.conf" << 'EOF'
+http {
+    accept_budget 128;
+    server {
+        listen localhost:8080;
+        root /var/www;
+        location / {
+            index index.html;
+        }
+    }
+}
+EOF
+
+    # 111. accept budget invalid
+    cat > "$TEST_DIR/111_accept_budget_invalid.conf" << 'EOF'
+http {
+    accept_budget 0;
+    server {
+        listen localhost:8080;
+        root /var/www;
+        location / {
+            index index.html;
+        }
+    }
+}
+EOF
+
+    # 112. worker connections
+    cat > "$TEST_DIR/112_worker_connections.conf" << 'EOF'
+http {
+    worker_connections 256;
+    server {
+        listen localhost:8080;
+        root /var/www;
+        location / {
+            index index.html;
+        }
+    }
+}
+EOF
+
+    # 113. worker connections invalid
+    cat > "$TEST_DIR/113_worker_connections_invalid.conf" << 'EOF'
+http {
+    worker_connections -5;
+    server {
+        listen localhost:8080;
+        root /var/www;
+        location / {
+            index index.html;
+        }
+    }
+}
+EOF
+
+    # 114. event backend io uring (removed)
+    cat > "$TEST_DIR/114_event_backend_io_uring.conf" << 'EOF'
+http {
+    event_backend io_uring;
+    server {
+        listen localhost:8080;
+        root /var/www;
+        location / {
+            index index.html;
+        }
+    }
+}
+EOF
+
+    # 115. open file cache
+    cat > "$TEST_DIR/115_open_file_cache.conf" << 'EOF'
+http {
+    open_file_cache max=1000 inactive=20s;
+    open_file_cache_valid 30s;
+    server {
+        listen localhost:8080;
+        root /var/www;
+        location / {
+            index index.html;
+        }
+    }
+}
+EOF
+
+    # 116. open file cache off
+    cat > "$TEST_DIR/116_open_file_cache_off.conf" << 'EOF'
+http {
+    open_file_cache off;
+    server {
+        listen localhost:8080;
+        root /var/www;
+        location / {
+            index index.html;
+        }
+    }
+}
+EOF
+
+    # 117. open file cache no max
+    cat > "$TEST_DIR/117_open_file_cache_no_max.conf" << 'EOF'
+http {
+    open_file_cache inactive=20s;
+    server {
+        listen localhost:8080;
+        root /var/www;
+        location / {
+            index index.html;
+        }
+    }
+}
+EOF
+
+    # 118. open file cache bad param
+    cat > "$TEST_DIR/118_open_file_cache_bad_param.conf" << 'EOF'
+http {
+    open_file_cache max=10 size=5;
+    server {
+        listen localhost:8080;
+        root /var/www;
+        location / {
+            index index.html;
+        }
+    }
+}
+EOF
+
+    # 119. open file cache valid invalid
+    cat > "$TEST_DIR/119_open_file_cache_valid_invalid.conf" << 'EOF'
+http {
+    open_file_cache_valid 10x;
+    server {
+        listen localhost:8080;
+        root /var/www;
+        location / {
+            index index.html;
+        }
+    }
+}
+EOF
+
+    # 120. content cache
+    cat > "$TEST_DIR/120_content_cache.conf" << 'EOF'
+http {
+    content_cache size=8m max_file=128k;
+    server {
+        listen localhost:8080;
+        root /var/www;
+        location / {
+            index index.html;
+        }
+    }
+}
+EOF
+
+    # 121. content cache off
+    cat > "$TEST_DIR/121_content_cache_off.conf" << 'EOF'
+http {
+    content_cache off;
+    server {
+        listen localhost:8080;
+        root /var/www;
+        location / {
+            index index.html;
+        }
+    }
+}
+EOF
+
+    # 122. content cache no size
+    cat > "$TEST_DIR/122_content_cache_no_size.conf" << 'EOF'
+http {
+    content_cache max_file=64k;
+    server {
+        listen localhost:8080;
+        root /var/www;
+        location / {
+            index index.html;
+        }
+    }
+}
+EOF
+
+    # 123. content cache bad size
+    cat > "$TEST_DIR/123_content_cache_bad_size.conf" << 'EOF'
+http {
+    content_cache size=10x;
+    server {
+        listen localhost:8080;
+        root /var/www;
+        location / {
+            index index.html;
+        }
+    }
+}
+EOF
+
+    # 124. content cache duplicate
+    cat > "$TEST_DIR/124_content_cache_duplicate.conf" << 'EOF'
+http {
+    content_cache size=1m;
+    content_cache size=2m;
+    server {
+        listen localhost:8080;
+        root /var/www;
+        location / {
+            index index.html;
+        }
+    }
+}
+EOF
+
+    # 125. gzip brotli static
+    cat > "$TEST_DIR/125_gzip_brotli_static.conf" << 'EOF'
+http {
+    server {
+        listen localhost:8080;
+        root /var/www;
+        location / {
+            index index.html;
+            gzip_static on;
+            brotli_static on;
+        }
+    }
+}
+EOF
+
+    # 126. gzip static invalid
+    cat > "$TEST_DIR/126_gzip_static_invalid.conf" << 'EOF'
+http {
+    server {
+        listen localhost:8080;
+        root /var/www;
+        location / {
+            index index.html;
+            gzip_static yes;
+        }
+    }
+}
+EOF
+
+    # 127. brotli static duplicate
+    cat > "$TEST_DIR/127_brotli_static_duplicate.conf" << 'EOF'
+http {
+    server {
+        listen localhost:8080;
+        root /var/www;
+        location / {
+            index index.html;
+            brotli_static on;
+            brotli_static off;
+        }
+    }
+}
+EOF
+
+    # 128. gzip dynamic
+    cat > "$TEST_DIR/128_gzip_dynamic.conf" << 'EOF'
+http {
+    server {
+        listen localhost:8080;
+        root /var/www;
+        location / {
+            index index.html;
+            gzip on;
+            gzip_types text/html text/plain application/json;
+            gzip_min_length 1k;
+            gzip_comp_level 6;
+        }
+    }
+}
+EOF
+
+    # 129. gzip invalid level
+    cat > "$TEST_DIR/129_gzip_invalid_level.conf" << 'EOF'
+http {
+    server {
+        listen localhost:8080;
+        root /var/www;
+        location / {
+            index index.html;
+            gzip on;
+            gzip_comp_level 10;
+        }
+    }
+}
+EOF
+
+    # 130. gzip invalid type
+    cat > "$TEST_DIR/130_gzip_invalid_type.conf" << 'EOF'
+http {
+    server {
+        listen localhost:8080;
+        root /var/www;
+        location / {
+            index index.html;
+            gzip_types html;
+        }
+    }
+}
+EOF
+
+    # 131. gzip duplicate
+    cat > "$TEST_DIR/131_gzip_duplicate.conf" << 'EOF'
+http {
+    server {
+        listen localhost:8080;
+        root /var/www;
+        location / {
+            index index.html;
+            gzip on;
+            gzip off;
+        }
+    }
+}
+EOF
+
+    # 132. expires cache control
+    cat > "$TEST_DIR/132_expires_cache_control.conf" << 'EOF'
+http {
+    server {
+        listen localhost:8080;
+        root /var/www;
+        location / {
+            index index.html;
+            expires 30d;
+            expires_by_type text/html epoch;
+            cache_control public, immutable;
+            cache_control_by_type text/css no-store;
+        }
+    }
+}
+EOF
+
+    # 133. expires invalid
+    cat > "$TEST_DIR/133_expires_invalid.conf" << 'EOF'
+http {
+    server {
+        listen localhost:8080;
+        root /var/www;
+        location / {
+            index index.html;
+            expires soon;
+        }
+    }
+}
+EOF
+
+    # 134. expires duplicate
+    cat > "$TEST_DIR/134_expires_duplicate.conf" << 'EOF'
+http {
+    server {
+        listen localhost:8080;
+        root /var/www;
+        location / {
+            index index.html;
+            expires max;
+            expires off;
+        }
+    }
+}
+EOF
+
+    # 135. expires by type duplicate
+    cat > "$TEST_DIR/135_expires_by_type_duplicate.conf" << 'EOF'
+http {
+    server {
+        listen localhost:8080;
+        root /var/www;
+        location / {
+            index index.html;
+            expires_by_type text/css 1h;
+            expires_by_type text/css 2h;
+        }
+    }
+}
+EOF
+
+    # 136. cache control by type invalid
+    cat > "$TEST_DIR/136_cache_control_by_type_invalid.conf" << 'EOF'
+http {
+    server {
+        listen localhost:8080;
+        root /var/www;
+        location / {
+            index index.html;
+            cache_control_by_type css no-cache;
+        }
+    }
+}
+EOF
+
+    # 137. pipeline depth
+    cat > "$TEST_DIR/137_pipeline_depth.conf" << 'EOF'
+http {
+    pipeline_depth 4;
+    server {
+        listen localhost:8080;
+        root /var/www;
+        location / {
+            index index.html;
+        }
+    }
+}
+EOF
+
+    # 138. pipeline depth invalid
+    cat > "$TEST_DIR/138_pipeline_depth_invalid.conf" << 'EOF'
+http {
+    pipeline_depth 0;
+    server {
+        listen localhost:8080;
+        root /var/www;
+        location / {
+            index index.html;
+        }
+    }
+}
 EOF
 
     echo -e "${GREEN}Generated $(ls -1 "$TEST_DIR"/*.conf 2>/dev/null | wc -l) test configuration files${NC}"
@@ -1495,6 +2063,51 @@ run_tests() {
     
     # Multiple values for root - should now FAIL
     test_failure "Multiple values for root" "$TEST_DIR/84_multi_value_root.conf" "[ERROR]: root takes exactly one value"
+
+    # ----------------------------------------------------------
+    # HTTP-LEVEL DIRECTIVES
+    # ----------------------------------------------------------
+    print_subheader "HTTP-level directives"
+
+    test_success "event_backend poll" "$TEST_DIR/100_event_backend_poll.conf"
+    test_failure "Invalid event_backend value" "$TEST_DIR/101_event_backend_invalid.conf" "invalid event_backend value"
+    test_failure "Duplicate event_backend" "$TEST_DIR/102_event_backend_dup.conf" "duplicate event_backend directive"
+    test_success "worker_processes auto" "$TEST_DIR/103_worker_processes_auto.conf"
+    test_failure "worker_processes zero" "$TEST_DIR/104_worker_processes_zero.conf" "invalid worker_processes value"
+    test_failure "Duplicate worker_processes" "$TEST_DIR/105_worker_processes_dup.conf" "duplicate worker_processes directive"
+    test_failure "Invalid worker_cpu_affinity" "$TEST_DIR/106_worker_cpu_affinity_invalid.conf" "invalid worker_cpu_affinity value"
+    test_success "worker_threads" "$TEST_DIR/107_worker_threads.conf"
+    test_failure "Invalid worker_threads" "$TEST_DIR/108_worker_threads_invalid.conf" "invalid worker_threads value"
+    test_failure "Duplicate worker_threads" "$TEST_DIR/109_worker_threads_dup.conf" "duplicate worker_threads directive"
+    test_success "accept_budget" "$TEST_DIR/110_accept_budget.conf"
+    test_failure "Invalid accept_budget" "$TEST_DIR/111_accept_budget_invalid.conf" "invalid accept_budget value"
+    test_success "worker_connections" "$TEST_DIR/112_worker_connections.conf"
+    test_failure "Invalid worker_connections" "$TEST_DIR/113_worker_connections_invalid.conf" "invalid worker_connections value"
+    test_failure "event_backend io_uring rejected" "$TEST_DIR/114_event_backend_io_uring.conf" "invalid event_backend value"
+    test_success "open_file_cache max/inactive/valid" "$TEST_DIR/115_open_file_cache.conf"
+    test_success "open_file_cache off" "$TEST_DIR/116_open_file_cache_off.conf"
+    test_failure "open_file_cache without max" "$TEST_DIR/117_open_file_cache_no_max.conf" "open_file_cache requires max=N or off"
+    test_failure "open_file_cache unknown parameter" "$TEST_DIR/118_open_file_cache_bad_param.conf" "invalid open_file_cache parameter"
+    test_failure "Invalid open_file_cache_valid" "$TEST_DIR/119_open_file_cache_valid_invalid.conf" "invalid open_file_cache_valid value"
+    test_success "content_cache size/max_file" "$TEST_DIR/120_content_cache.conf"
+    test_success "content_cache off" "$TEST_DIR/121_content_cache_off.conf"
+    test_failure "content_cache without size" "$TEST_DIR/122_content_cache_no_size.conf" "content_cache requires size=N or off"
+    test_failure "Invalid content_cache size" "$TEST_DIR/123_content_cache_bad_size.conf" "invalid content_cache size"
+    test_failure "Duplicate content_cache" "$TEST_DIR/124_content_cache_duplicate.conf" "duplicate content_cache directive"
+    test_success "gzip_static and brotli_static" "$TEST_DIR/125_gzip_brotli_static.conf"
+    test_failure "Invalid gzip_static value" "$TEST_DIR/126_gzip_static_invalid.conf" "invalid gzip_static value"
+    test_failure "Duplicate brotli_static" "$TEST_DIR/127_brotli_static_duplicate.conf" "duplicate brotli_static directive"
+    test_success "gzip with types/min_length/comp_level" "$TEST_DIR/128_gzip_dynamic.conf"
+    test_failure "Invalid gzip_comp_level" "$TEST_DIR/129_gzip_invalid_level.conf" "invalid gzip_comp_level value"
+    test_failure "Invalid gzip_types entry" "$TEST_DIR/130_gzip_invalid_type.conf" "invalid gzip_types MIME type"
+    test_failure "Duplicate gzip" "$TEST_DIR/131_gzip_duplicate.conf" "duplicate gzip directive"
+    test_success "expires/cache_control with per-type overrides" "$TEST_DIR/132_expires_cache_control.conf"
+    test_failure "Invalid expires value" "$TEST_DIR/133_expires_invalid.conf" "invalid expires value"
+    test_failure "Duplicate expires" "$TEST_DIR/134_expires_duplicate.conf" "duplicate expires directive"
+    test_failure "Duplicate expires_by_type" "$TEST_DIR/135_expires_by_type_duplicate.conf" "duplicate expires_by_type for text/css"
+    test_failure "Invalid cache_control_by_type MIME type" "$TEST_DIR/136_cache_control_by_type_invalid.conf" "invalid cache_control_by_type MIME type"
+    test_success "pipeline_depth" "$TEST_DIR/137_pipeline_depth.conf"
+    test_failure "Invalid pipeline_depth" "$TEST_DIR/138_pipeline_depth_invalid.conf" "invalid pipeline_depth value"
 }
 
 # ============================================================
@@ -0,0 +1,156 @@
+#!/bin/bash
+
+# ============================================================
+# Pipeline Tester
+# Starts webserv, sends pipelined requests and checks that
+# every request is answered, in order
+# ============================================================
+
+SERVER="./webserv"
+TEST_DIR="pipeline_tests"
+PORT=8099
+
+# Colors
+RED='\033[0;31m'
+GREEN='\033[0;32m'
+YELLOW='\033[1;33m'
+BLUE='\033[0;34m'
+NC='\033[0m'
+
+PASS_COUNT=0
+FAIL_COUNT=0
+TOTAL_COUNT=0
+
+print_header() {
+    echo ""
+    echo -e "${BLUE}═══════════════════════════════════════════════════════════${NC}"
+    echo -e "${BLUE}  $1${NC}"
+    echo -e "${BLUE}═══════════════════════════════════════════════════════════${NC}"
+}
+
+print_subheader() {
+    echo ""
+    echo -e "${YELLOW}──────────────────────────────────────────────────────────${NC}"
+    echo -e "${YELLOW}  $1${NC}"
+    echo -e "${YELLOW}──────────────────────────────────────────────────────────${NC}"
+}
+
+# Test function
+# Args: test_name request_content expected_status_codes
+# The last pipelined request should carry "Connection: close" so the
+# server ends the connection once everything is answered.
+run_test() {
+    local test_name="$1"
+    local request_content="$2"
+    local expected_codes="$3"
+
+    TOTAL_COUNT=$((TOTAL_COUNT + 1))
+
+    local actual_codes
+    actual_codes=$(
+        exec 3<>"/dev/tcp/127.0.0.1/$PORT" || exit 1
+        printf "%b" "$request_content" >&3
+        timeout 5 cat <&3 | grep -ao "HTTP/1\.1 [0-9]*" | cut -d' ' -f2 | tr '\n' ' ' | sed 's/ $//'
+    )
+
+    if [ "$actual_codes" = "$expected_codes" ]; then
+        echo -e "${GREEN}✅ PASS${NC} [$TOTAL_COUNT] $test_name"
+        PASS_COUNT=$((PASS_COUNT + 1))
+        return 0
+    else
+        echo -e "${RED}❌ FAIL${NC} [$TOTAL_COUNT] $test_name"
+        echo -e "${RED}   Expected status codes '$expected_codes', got '$actual_codes'${NC}"
+        FAIL_COUNT=$((FAIL_COUNT + 1))
+        return 1
+    fi
+}
+
+# ============================================================
+# Check if server binary exists
+# ============================================================
+
+print_header "Pipeline Tester"
+
+if [ ! -f "$SERVER" ]; then
+    echo -e "${RED}❌ Error: $SERVER not found${NC}"
+    echo -e "${YELLOW}Please compile first: make${NC}"
+    exit 1
+fi
+
+CWD=$(pwd)
+rm -rf "$TEST_DIR"
+mkdir -p "$TEST_DIR/www" "$TEST_DIR/uploads"
+echo "welcome" > "$TEST_DIR/www/welcome.html"
+
+cat > "$TEST_DIR/pipeline.conf" <<EOF
+http {
+    server {
+        listen 127.0.0.1:$PORT;
+        server_name localhost;
+        root $CWD/$TEST_DIR/www;
+        location / {
+            methods GET;
+            index welcome.html;
+        }
+        location /up {
+            methods POST;
+            upload_dir $CWD/$TEST_DIR/uploads;
+        }
+        location /cgi-bin {
+            root $CWD/www/cgi-bin;
+            methods GET POST;
+            cgi_pass .py /usr/bin/python3;
+        }
+    }
+}
+EOF
+
+$SERVER "$TEST_DIR/pipeline.conf" > "$TEST_DIR/server.log" 2>&1 &
+SERVER_PID=$!
+sleep 1
+
+# ============================================================
+# PIPELINED REQUEST TESTS
+# ============================================================
+
+print_subheader "Pipelined Request Tests"
+
+GET_CLOSE='GET /welcome.html HTTP/1.1\r\nHost: localhost\r\nConnection: close\r\n\r\n'
+
+run_test "GET, GET, GET" \
+"GET /welcome.html HTTP/1.1\r\nHost: localhost\r\n\r\nGET /missing HTTP/1.1\r\nHost: localhost\r\n\r\n$GET_CLOSE" \
+"200 404 200"
+
+run_test "Content-Length POST then GET" \
+"POST /up HTTP/1.1\r\nHost: localhost\r\nContent-Length: 5\r\n\r\nhello$GET_CLOSE" \
+"201 200"
+
+run_test "Chunked POST then GET" \
+"POST /up HTTP/1.1\r\nHost: localhost\r\nTransfer-Encoding: chunked\r\n\r\n5\r\nhello\r\n0\r\n\r\n$GET_CLOSE" \
+"201 200"
+
+run_test "Chunked CGI POST then GET" \
+"POST /cgi-bin/database.py HTTP/1.1\r\nHost: localhost\r\nTransfer-Encoding: chunked\r\n\r\n5\r\nhello\r\n0\r\n\r\n$GET_CLOSE" \
+"200 200"
+
+kill $SERVER_PID
+wait $SERVER_PID 2>/dev/null
+
+# ============================================================
+# SUMMARY
+# ============================================================
+
+print_header "Test Summary"
+echo "Total Tests: $TOTAL_COUNT"
+echo -e "${GREEN}Passed: $PASS_COUNT${NC}"
+echo -e "${RED}Failed: $FAIL_COUNT${NC}"
+
+if [ $FAIL_COUNT -eq 0 ]; then
+    echo ""
+    echo -e "${GREEN}🎉 All tests passed!${NC}"
+    exit 0
+else
+    echo ""
+    echo -e "${RED}❌ Some tests failed${NC}"
+    exit 1
+fi
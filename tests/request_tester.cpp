@@ -18,6 +18,26 @@ String readFile(const String& filename) {
     return buffer.str();
 }
 
+// The server's path: the head is scanned as it arrives, here one byte at a
+// time, and parsed once the blank line is found.
+static void printStreamed(const String& raw) {
+    HttpRequest request;
+    size_t      headLength = 0;
+    bool        found      = false;
+    for (size_t size = 1; size <= raw.size() && !found; ++size)
+        found = request.scanHead(raw.data(), size, headLength);
+    bool parsed = found && request.parseHead(raw.data(), headLength);
+    std::cout << "streamedHead=" << (parsed ? "true" : "false") << std::endl;
+    if (parsed) {
+        std::cout << "headLength=" << headLength << std::endl;
+        std::cout << "streamedUri=" << request.getUri() << std::endl;
+        std::cout << "connection=" << request.getHeader(FIELD_CONNECTION) << std::endl;
+        std::cout << "accept=" << request.getHeader("accept") << std::endl;
+        std::cout << "chunked=" << (request.hasHeaderToken(FIELD_TRANSFER_ENCODING, "chunked") ? "true" : "false") << std::endl;
+        std::cout << "keepAlive=" << (request.hasHeaderToken(FIELD_CONNECTION, "keep-alive") ? "true" : "false") << std::endl;
+    }
+}
+
 int main(int argc, char* argv[]) {
     if (argc < 2) {
         std::cerr << "Usage: " << argv[0] << " <request_file.http>" << std::endl;
@@ -41,7 +61,12 @@ int main(int argc, char* argv[]) {
         std::cout << "bodyLength=" << request.getBody().length() << std::endl;
         std::cout << "isComplete=" << (request.isComplete() ? "true" : "false") << std::endl;
         std::cout << "hasBody=" << (request.hasBody() ? "true" : "false") << std::endl;
+        std::cout << "queryString=" << request.getQueryString() << std::endl;
+        const MapString& params = request.getQueryParams();
+        for (MapString::const_iterator it = params.begin(); it != params.end(); ++it)
+            std::cout << "query[" << it->first << "]=" << it->second << std::endl;
     }
+    printStreamed(rawRequest);
 
     return parseResult ? 0 : 1;
 }
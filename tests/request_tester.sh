@@ -122,6 +122,43 @@ run_test() {
     fi
 }
 
+# Test function for fields printed regardless of parseResult
+# Args: test_name request_content expected_line...
+# Each expected_line is a "key=value" line the tester must print.
+run_field_test() {
+    local test_name="$1"
+    local request_content="$2"
+    shift 2
+
+    TOTAL_COUNT=$((TOTAL_COUNT + 1))
+
+    local test_file="$TEST_DIR/test_${TOTAL_COUNT}.txt"
+    printf "%b" "$request_content" > "$test_file"
+
+    output=$($TESTER "$test_file" 2>&1)
+
+    local passed=true
+    local errors=""
+    local expected
+    for expected in "$@"; do
+        if ! echo "$output" | grep -qxF -- "$expected"; then
+            passed=false
+            errors="${errors}   Expected $expected, got $(echo "$output" | grep "^${expected%%=*}=" | head -1)\n"
+        fi
+    done
+
+    if [ "$passed" = true ]; then
+        echo -e "${GREEN}✅ PASS${NC} [$TOTAL_COUNT] $test_name"
+        PASS_COUNT=$((PASS_COUNT + 1))
+        return 0
+    else
+        echo -e "${RED}❌ FAIL${NC} [$TOTAL_COUNT] $test_name"
+        echo -e "${RED}${errors}${NC}"
+        FAIL_COUNT=$((FAIL_COUNT + 1))
+        return 1
+    fi
+}
+
 # ============================================================
 # Check if tester binary exists
 # ============================================================
@@ -246,6 +283,95 @@ run_test "Zero content length" \
 $'POST / HTTP/1.1\r\nHost: localhost:8080\r\nContent-Length: 0\r\n\r\n' \
 "true" "POST" "/" "localhost" "8080"
 
+# ============================================================
+# INCREMENTAL HEAD PARSER TESTS
+# The head is fed one byte at a time through scanHead(), as the
+# server receives it, then parsed with parseHead()
+# ============================================================
+
+print_subheader "Incremental Head Parser Tests"
+
+# Test 19: Head found one byte at a time
+run_field_test "Head scanned byte by byte" \
+$'GET /index.html HTTP/1.1\r\nHost: localhost:8080\r\n\r\n' \
+"streamedHead=true" "headLength=50" "streamedUri=/index.html"
+
+# Test 20: Bare LF line ends
+run_field_test "Bare LF line ends" \
+$'GET /page HTTP/1.1\nHost: localhost:8080\nConnection: close\n\n' \
+"streamedHead=true" "headLength=59" "streamedUri=/page" "connection=close"
+
+# Test 21: Mixed CRLF and bare LF
+run_field_test "Mixed CRLF and bare LF" \
+$'GET /page HTTP/1.1\r\nHost: localhost:8080\nAccept: text/html\r\n\n' \
+"streamedHead=true" "accept=text/html"
+
+# Test 22: Body bytes after the head are not part of it
+run_field_test "Head length stops at the blank line" \
+$'POST / HTTP/1.1\r\nHost: localhost:8080\r\nContent-Length: 4\r\n\r\nbody' \
+"streamedHead=true" "headLength=60"
+
+# Test 23: Repeated header joined in order
+run_field_test "Repeated header joined" \
+$'GET / HTTP/1.1\r\nHost: localhost:8080\r\nAccept: text/html\r\nAccept: application/json\r\n\r\n' \
+"streamedHead=true" "accept=text/html,application/json"
+
+# Test 24: Header names are case-insensitive
+run_field_test "Header name case" \
+$'GET / HTTP/1.1\r\nhOsT: localhost:8080\r\nCONNECTION: close\r\n\r\n' \
+"streamedHead=true" "connection=close"
+
+# Test 25: Token found in a comma-separated list, any case
+run_field_test "hasHeaderToken in a list" \
+$'GET / HTTP/1.1\r\nHost: localhost:8080\r\nConnection: Upgrade ,  Keep-Alive\r\n\r\n' \
+"streamedHead=true" "keepAlive=true"
+
+# Test 26: Token found in a repeated header
+run_field_test "hasHeaderToken across repeated headers" \
+$'POST / HTTP/1.1\r\nHost: localhost:8080\r\nTransfer-Encoding: gzip\r\nTransfer-Encoding: chunked\r\n\r\n' \
+"streamedHead=true" "chunked=true"
+
+# Test 27: A token must match whole
+run_field_test "hasHeaderToken ignores partial tokens" \
+$'POST / HTTP/1.1\r\nHost: localhost:8080\r\nTransfer-Encoding: xchunked, chunkedx\r\n\r\n' \
+"streamedHead=true" "chunked=false"
+
+# Test 28: Two Content-Length headers are rejected
+run_field_test "Repeated Content-Length" \
+$'POST / HTTP/1.1\r\nHost: localhost:8080\r\nContent-Length: 4\r\nContent-Length: 4\r\n\r\nbody' \
+"parseResult=false" "streamedHead=false"
+
+# Test 29: Header line without a colon
+run_field_test "Header line without colon" \
+$'GET / HTTP/1.1\r\nHost: localhost:8080\r\nBroken header\r\n\r\n' \
+"parseResult=false" "streamedHead=false"
+
+# Test 30: Incomplete head
+run_field_test "Incomplete head" \
+$'GET / HTTP/1.1\r\nHost: localhost:8080\r\n' \
+"streamedHead=false"
+
+# ============================================================
+# QUERY STRING TESTS
+# ============================================================
+
+print_subheader "Query String Tests"
+
+# Test 31: Query string kept as received
+run_field_test "Query string kept raw" \
+$'GET /search?q=a%26b+c&page=1 HTTP/1.1\r\nHost: localhost:8080\r\n\r\n' \
+"queryString=q=a%26b+c&page=1"
+
+# Test 32: Parameters decoded on access
+run_field_test "Query parameters decoded" \
+$'GET /search?q=a%26b+c&page=1 HTTP/1.1\r\nHost: localhost:8080\r\n\r\n' \
+"query[q]=a&b c" "query[page]=1"
+
+# Test 33: Empty pairs skipped, missing '=' gives an empty value, first repeat wins
+run_field_test "Query edge cases" \
+$'GET /s?&flag&x=1&x=2&%41=%42 HTTP/1.1\r\nHost: localhost:8080\r\n\r\n' \
+"query[flag]=" "query[x]=1" "query[A]=B"
+
 # ============================================================
 # SUMMARY
 # ============================================================
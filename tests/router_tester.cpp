@@ -4,6 +4,7 @@
 #include <csignal>
 #include "../src/config/ConfigParser.hpp"
 #include "../src/http/HttpRequest.hpp"
+#include "../src/http/ResponseBuilder.hpp"
 #include "../src/http/Router.hpp"
 volatile sig_atomic_t g_running = 1;
 // Read file content into string
@@ -21,7 +22,7 @@ String readFile(const String& filename) {
 
 int main(int argc, char* argv[]) {
     if (argc < 3) {
-        std::cerr << "Usage: " << argv[0] << " <config_file> <request_file>" << std::endl;
+        std::cerr << "Usage: " << argv[0] << " <config_file> <request_file> [body_file]" << std::endl;
         return 1;
     }
 
@@ -68,5 +69,34 @@ int main(int argc, char* argv[]) {
     std::cout << "isUploadRequest=" << (result.getIsUploadRequest() ? "true" : "false") << std::endl;
     std::cout << "errorMessage=" << result.getErrorMessage() << std::endl;
 
+    // 5. Build the response, except for handlers with side effects
+    HandlerType type = result.getHandlerType();
+    if (type == CGI || type == UPLOAD || type == DELETE_FILE)
+        return 0;
+    ResponseBuilder builder;
+    HttpResponse    response = builder.build(result);
+    std::cout << "responseStatus=" << response.getStatusCode() << std::endl;
+    std::cout << "contentType=" << response.getHeader(HEADER_CONTENT_TYPE) << std::endl;
+    std::cout << "contentLength=" << response.getHeader(HEADER_CONTENT_LENGTH) << std::endl;
+    std::cout << "contentRange=" << response.getHeader(HEADER_CONTENT_RANGE) << std::endl;
+    std::cout << "contentEncoding=" << response.getHeader(HEADER_CONTENT_ENCODING) << std::endl;
+    std::cout << "lastModified=" << response.getHeader(HEADER_LAST_MODIFIED) << std::endl;
+    std::cout << "etag=" << response.getHeader(HEADER_ETAG) << std::endl;
+
+    // 6. Optionally write the body to a file
+    // (sendfile() needs an fd without O_APPEND)
+    if (argc > 3) {
+        int fd = open(argv[3], O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0)
+            return 1;
+        const String& body = response.getBody();
+        if (!body.empty() && write(fd, body.data(), body.size()) < 0)
+            std::cout << "ERROR|Cannot write body" << std::endl;
+        IBodySource* source = response.releaseBodySource();
+        while (source && !source->isDone() && source->writeTo(fd, BUFFER_SIZE) > 0)
+            ;
+        delete source;
+        close(fd);
+    }
     return 0;
 }
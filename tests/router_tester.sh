@@ -147,6 +147,62 @@ run_test() {
     fi
 }
 
+# Test function for the built response
+# Args: test_name config_content request_content expected_line...
+# Each expected_line is a "key=value" glob one output line must match;
+# "body=..." is compared with the response body instead.
+run_response_test() {
+    local test_name="$1"
+    local config_content="$2"
+    local request_content="$3"
+    shift 3
+
+    TOTAL_COUNT=$((TOTAL_COUNT + 1))
+
+    local config_file="$TEST_DIR/config_${TOTAL_COUNT}.conf"
+    local request_file="$TEST_DIR/request_${TOTAL_COUNT}.txt"
+    BODY_FILE="$TEST_DIR/body_${TOTAL_COUNT}.out"
+
+    printf "%s" "$config_content" > "$config_file"
+    printf "%b" "$request_content" > "$request_file"
+
+    output=$($TESTER "$config_file" "$request_file" "$BODY_FILE" 2>&1)
+
+    local passed=true
+    local errors=""
+    local expected
+    local line
+    local found
+    for expected in "$@"; do
+        if [ "${expected%%=*}" = "body" ]; then
+            if [ "$(cat "$BODY_FILE")" != "${expected#body=}" ]; then
+                passed=false
+                errors="${errors}   Expected $expected, got body=$(cat "$BODY_FILE")\n"
+            fi
+            continue
+        fi
+        found=false
+        while IFS= read -r line; do
+            [[ "$line" == $expected ]] && found=true
+        done <<< "$output"
+        if [ "$found" = false ]; then
+            passed=false
+            errors="${errors}   Expected $expected, got $(echo "$output" | grep "^${expected%%=*}=" | head -1)\n"
+        fi
+    done
+
+    if [ "$passed" = true ]; then
+        echo -e "${GREEN}✅ PASS${NC} [$TOTAL_COUNT] $test_name"
+        PASS_COUNT=$((PASS_COUNT + 1))
+        return 0
+    else
+        echo -e "${RED}❌ FAIL${NC} [$TOTAL_COUNT] $test_name"
+        echo -e "${RED}${errors}${NC}"
+        FAIL_COUNT=$((FAIL_COUNT + 1))
+        return 1
+    fi
+}
+
 # ============================================================
 # Check if tester binary exists
 # ============================================================
@@ -435,6 +491,160 @@ REQUEST=$'GET / HTTP/1.1\r\nHost: localhost:9999\r\n\r\n'
 
 run_test "Wrong port (no server)" "$CONFIG" "$REQUEST" "400" "" ""
 
+# ============================================================
+# BYTE RANGE TESTS
+# ============================================================
+
+print_subheader "Byte Range Tests"
+
+printf "0123456789abcdefghij" > "$TEST_DIR/www/range.txt"
+touch -d "2020-01-01 00:00:00 UTC" "$TEST_DIR/www/range.txt"
+MTIME_DATE="Wed, 01 Jan 2020 00:00:00 GMT"
+ETAG=$(printf '"%x-%x-%x"' "$(stat -c %i "$TEST_DIR/www/range.txt")" 20 "$(stat -c %Y "$TEST_DIR/www/range.txt")")
+
+CONFIG="http {
+    server {
+        listen localhost:8080;
+        server_name localhost;
+        root $CWD/$TEST_DIR/www;
+        location / {
+            methods GET;
+            index index.html;
+        }
+    }
+}"
+
+range_request() {
+    printf '%s' "GET /range.txt HTTP/1.1\r\nHost: localhost:8080\r\n$1\r\n"
+}
+
+run_response_test "First bytes" "$CONFIG" "$(range_request 'Range: bytes=0-4\r\n')" \
+"responseStatus=206" "contentRange=bytes 0-4/20" "contentLength=5" "body=01234"
+
+run_response_test "Suffix range" "$CONFIG" "$(range_request 'Range: bytes=-5\r\n')" \
+"responseStatus=206" "contentRange=bytes 15-19/20" "body=fghij"
+
+run_response_test "Suffix longer than the file" "$CONFIG" "$(range_request 'Range: bytes=-50\r\n')" \
+"responseStatus=206" "contentRange=bytes 0-19/20"
+
+run_response_test "Open-ended range" "$CONFIG" "$(range_request 'Range: bytes=15-\r\n')" \
+"responseStatus=206" "contentRange=bytes 15-19/20" "body=fghij"
+
+run_response_test "Range end clamped to the file" "$CONFIG" "$(range_request 'Range: bytes=18-100\r\n')" \
+"responseStatus=206" "contentRange=bytes 18-19/20" "body=ij"
+
+run_response_test "Several ranges" "$CONFIG" "$(range_request 'Range: bytes=0-1, 5-6\r\n')" \
+"responseStatus=206" "contentType=multipart/byteranges; boundary=*" "contentRange="
+
+run_response_test "Range starting past the end is dropped" "$CONFIG" "$(range_request 'Range: bytes=30-40, 0-0\r\n')" \
+"responseStatus=206" "contentRange=bytes 0-0/20" "body=0"
+
+run_response_test "No satisfiable range" "$CONFIG" "$(range_request 'Range: bytes=20-30\r\n')" \
+"responseStatus=416" "contentRange=bytes \*/20"
+
+run_response_test "Malformed range ignored" "$CONFIG" "$(range_request 'Range: bytes=5-1\r\n')" \
+"responseStatus=200" "contentLength=20" "contentRange="
+
+run_response_test "Other units ignored" "$CONFIG" "$(range_request 'Range: items=0-4\r\n')" \
+"responseStatus=200" "contentLength=20"
+
+run_response_test "If-Range with the current date" "$CONFIG" "$(range_request "Range: bytes=0-4\r\nIf-Range: $MTIME_DATE\r\n")" \
+"responseStatus=206" "contentRange=bytes 0-4/20"
+
+run_response_test "If-Range with an older date" "$CONFIG" "$(range_request 'Range: bytes=0-4\r\nIf-Range: Tue, 31 Dec 2019 00:00:00 GMT\r\n')" \
+"responseStatus=200" "contentLength=20"
+
+run_response_test "If-Range with the current ETag" "$CONFIG" "$(range_request "Range: bytes=0-4\r\nIf-Range: $ETAG\r\n")" \
+"responseStatus=206" "contentRange=bytes 0-4/20"
+
+run_response_test "If-Range with another ETag" "$CONFIG" "$(range_request 'Range: bytes=0-4\r\nIf-Range: "other"\r\n')" \
+"responseStatus=200" "contentLength=20"
+
+# ============================================================
+# CONDITIONAL REQUEST TESTS
+# ============================================================
+
+print_subheader "Conditional Request Tests"
+
+run_response_test "Validators on a full response" "$CONFIG" "$(range_request '')" \
+"responseStatus=200" "lastModified=$MTIME_DATE" "etag=$ETAG" "body=0123456789abcdefghij"
+
+run_response_test "If-None-Match with the ETag" "$CONFIG" "$(range_request "If-None-Match: \"x\", $ETAG\r\n")" \
+"responseStatus=304" "etag=$ETAG"
+
+run_response_test "If-None-Match with a weak ETag" "$CONFIG" "$(range_request "If-None-Match: W/$ETAG\r\n")" \
+"responseStatus=304"
+
+run_response_test "If-None-Match: *" "$CONFIG" "$(range_request 'If-None-Match: *\r\n')" \
+"responseStatus=304"
+
+run_response_test "If-None-Match wins over If-Modified-Since" "$CONFIG" "$(range_request "If-None-Match: \"other\"\r\nIf-Modified-Since: $MTIME_DATE\r\n")" \
+"responseStatus=200"
+
+run_response_test "If-Modified-Since at the mtime" "$CONFIG" "$(range_request "If-Modified-Since: $MTIME_DATE\r\n")" \
+"responseStatus=304" "lastModified=$MTIME_DATE"
+
+run_response_test "If-Modified-Since before the mtime" "$CONFIG" "$(range_request 'If-Modified-Since: Tue, 31 Dec 2019 23:59:59 GMT\r\n')" \
+"responseStatus=200"
+
+run_response_test "If-Modified-Since in RFC 850 format" "$CONFIG" "$(range_request 'If-Modified-Since: Wednesday, 01-Jan-20 00:00:00 GMT\r\n')" \
+"responseStatus=304"
+
+run_response_test "If-Modified-Since in asctime format" "$CONFIG" "$(range_request 'If-Modified-Since: Wed Jan  1 00:00:00 2020\r\n')" \
+"responseStatus=304"
+
+run_response_test "Invalid If-Modified-Since ignored" "$CONFIG" "$(range_request 'If-Modified-Since: yesterday\r\n')" \
+"responseStatus=200"
+
+# ============================================================
+# GZIP TESTS
+# Generated bodies compressed for HTTP/1.0 clients are compared,
+# once decompressed, with the uncompressed response
+# ============================================================
+
+print_subheader "Gzip Tests"
+
+mkdir -p "$TEST_DIR/www/listing"
+for i in $(seq 1 300); do
+    : > "$TEST_DIR/www/listing/file_$i.txt"
+done
+
+CONFIG="http {
+    server {
+        listen localhost:8080;
+        server_name localhost;
+        root $CWD/$TEST_DIR/www;
+        location / {
+            methods GET;
+            autoindex on;
+            gzip on;
+        }
+    }
+}"
+
+run_gzip_test() {
+    local test_name="$1"
+    local uri="$2"
+
+    run_response_test "$test_name (plain)" "$CONFIG" "GET $uri HTTP/1.0\r\nHost: localhost:8080\r\n\r\n" "contentEncoding="
+    local plain="$BODY_FILE"
+    run_response_test "$test_name (gzip)" "$CONFIG" "GET $uri HTTP/1.0\r\nHost: localhost:8080\r\nAccept-Encoding: gzip\r\n\r\n" \
+        "contentEncoding=gzip"
+
+    TOTAL_COUNT=$((TOTAL_COUNT + 1))
+    if gunzip -c "$BODY_FILE" 2>/dev/null | cmp -s - "$plain" && [ -s "$plain" ]; then
+        echo -e "${GREEN}✅ PASS${NC} [$TOTAL_COUNT] $test_name round-trip"
+        PASS_COUNT=$((PASS_COUNT + 1))
+    else
+        echo -e "${RED}❌ FAIL${NC} [$TOTAL_COUNT] $test_name round-trip"
+        echo -e "${RED}   gunzip output differs from the uncompressed body${NC}"
+        FAIL_COUNT=$((FAIL_COUNT + 1))
+    fi
+}
+
+run_gzip_test "Error page" "/missing"
+run_gzip_test "Directory listing" "/listing/"
+
 # ============================================================
 # SUMMARY
 # ============================================================
@@ -0,0 +1,92 @@
+#include <sys/time.h>
+#include <csignal>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include "../src/utils/Utils.hpp"
+
+volatile sig_atomic_t g_running = 1;
+
+// Microbenchmark for ByteScan: nanoseconds per scanned byte next to
+// std::string::find. The searches are first checked against
+// std::string::find on random inputs.
+
+static double nowSeconds() {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec + tv.tv_usec / 1e6;
+}
+
+// Header-like text with no CR, LF or NUL, so every scan runs to the end.
+static String makeText(size_t size) {
+    static const char alphabet[] = "abcdefghijklmnopqrstuvwxyz ABCDEFGHIJ:/;=-0123456789";
+    String            text(size, 'a');
+    for (size_t i = 0; i < size; ++i)
+        text[i] = alphabet[std::rand() % (sizeof(alphabet) - 1)];
+    return text;
+}
+
+static bool check() {
+    for (int round = 0; round < 20000; ++round) {
+        String s(std::rand() % 200, 'a');
+        for (size_t i = 0; i < s.size(); ++i)
+            s[i] = "\r\n-ab:"[std::rand() % 6];
+        size_t from = s.empty() ? 0 : std::rand() % (s.size() + 1);
+        String needle(1 + std::rand() % 4, 'a');
+        for (size_t i = 0; i < needle.size(); ++i)
+            needle[i] = "\r\n-ab:"[std::rand() % 6];
+        if (findByte(s, ':', from) != s.find(':', from) || findCrlf(s, from) != s.find(CRLF, from) ||
+            findSequence(s, needle, from) != s.find(needle, from)) {
+            std::cout << "MISMATCH" << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+static void report(const char* name, size_t bytes, double seconds) {
+    std::cout << std::left << std::setw(24) << name << std::right << std::fixed << std::setprecision(4)
+              << seconds * 1e9 / bytes << " ns/byte" << std::endl;
+}
+
+int main() {
+    const size_t    size   = 1 << 20;
+    const int       rounds = 200;
+    String          text   = makeText(size);
+    String          boundary("--------------------------4d2a1f0c9b");
+    volatile size_t sink = 0;
+
+    if (!check())
+        return 1;
+
+    double start = nowSeconds();
+    for (int i = 0; i < rounds; ++i)
+        sink += text.find('\n');
+    report("string::find(char)", size * rounds, nowSeconds() - start);
+    start = nowSeconds();
+    for (int i = 0; i < rounds; ++i)
+        sink += text.find(DOUBLE_CRLF);
+    report("string::find(CRLFCRLF)", size * rounds, nowSeconds() - start);
+    start = nowSeconds();
+    for (int i = 0; i < rounds; ++i)
+        sink += text.find(boundary);
+    report("string::find(boundary)", size * rounds, nowSeconds() - start);
+
+    start = nowSeconds();
+    for (int i = 0; i < rounds; ++i)
+        sink += findByte(text, '\n');
+    report("findByte", size * rounds, nowSeconds() - start);
+    start = nowSeconds();
+    for (int i = 0; i < rounds; ++i)
+        sink += findCrlf(text);
+    report("findCrlf", size * rounds, nowSeconds() - start);
+    start = nowSeconds();
+    for (int i = 0; i < rounds; ++i)
+        sink += findSequence(text, DOUBLE_CRLF);
+    report("findSequence(CRLFCRLF)", size * rounds, nowSeconds() - start);
+    start = nowSeconds();
+    for (int i = 0; i < rounds; ++i)
+        sink += findSequence(text, boundary);
+    report("findSequence(boundary)", size * rounds, nowSeconds() - start);
+    return 0;
+}